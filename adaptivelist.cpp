@@ -0,0 +1,249 @@
+/*
+ * Title:		Adaptive List
+ * Purpose:		Implementation of a list that switches between an array and a
+ * 				linked representation. Every operation is charged with what it
+ * 				would have cost in both representations; at the end of each
+ * 				window the list migrates if the other representation would
+ * 				have been cheaper by a margin that pays for the migration.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "adaptivelist.h"
+
+#include <string>
+using std::string;
+
+const double AdaptiveList::HYSTERESIS = 0.25;
+const double AdaptiveList::MIGRATION_COST = 2.0;
+const double AdaptiveList::LINK_COST = 2.0;
+
+/**
+ * Default Constructor
+ * An empty window, nothing observed yet
+ */
+AdaptiveList::Workload::Workload() : arrayCost(0), linkedCost(0){
+	for (size_t op = 0; op < ListStats::OPERATION_COUNT; op++){
+		operations[op] = 0;
+	}
+	for (size_t r = 0; r < REGION_COUNT; r++){
+		positions[r] = 0;
+	}
+}
+/**
+ * Constructor
+ * The list starts as an array, the parameters are used every time the
+ * array representation is created.
+ * @param capacity the initial capacity of the array representation
+ * @param increasePercentage the growth of the array representation
+ */
+AdaptiveList::AdaptiveList(size_t capacity, double increasePercentage) :
+		_storage(new VSArray(capacity, increasePercentage)), _representation(ARRAY), _capacity(capacity),
+		_delta(increasePercentage), _migrations(0){
+
+}
+/**
+ * Destructor
+ * The storage owns the elements and releases them
+ */
+AdaptiveList::~AdaptiveList(){
+	delete _storage;
+}
+/**
+ * Inserts an element into a given position.
+ * The array pays for shifting the elements after the position, the
+ * linked list pays for walking from the head unless it inserts at one
+ * of the ends.
+ * @param element what the client wants to insert into the list
+ * @param position the position where the element is to be inserted
+ * @return true if it was possible to insert, false if the position is invalid
+ */
+bool AdaptiveList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (!_storage->Insert(element, position)){
+		return false;
+	}
+	size_t before = _size;
+	_size++;
+	bool atEnd = position == 0 || position == before;
+	Observe(ListStats::INSERT, position, before - position + 1.0,
+			atEnd ? LINK_COST : (position + 1.0) * LINK_COST);
+	return true;
+}
+/**
+ * Searches for the position of an element in the list.
+ * Both representations scan the same number of elements, the linked one
+ * also pays for following the links.
+ * @param element the object that the client is searching for.
+ * @return the position of the element if found, -1 otherwise.
+ */
+int AdaptiveList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	int retVal = _storage->IndexOf(element);
+	size_t scanned = retVal < 0 ? _size : retVal + 1;
+	Observe(ListStats::INDEX_OF, scanned == 0 ? 0 : scanned - 1, scanned, scanned * LINK_COST);
+	return retVal;
+}
+/**
+ * Removes the element at position, when the position is valid.
+ * The array pays for shifting the elements after the position, the
+ * linked list pays for walking from the head.
+ * @param position the position of the element to be removed.
+ * @return the removed element if the position was valid, nullptr otherwise
+ */
+Object* AdaptiveList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	Object* retVal = _storage->Remove(position);
+	if (retVal == nullptr){
+		return nullptr;
+	}
+	size_t before = _size;
+	_size--;
+	Observe(ListStats::REMOVE, position, before - position, position == 0 ? LINK_COST : position * LINK_COST);
+	return retVal;
+}
+/**
+ * Element Access
+ * Constant for the array, a walk from the head for the linked list.
+ * @param position the position of the element to retrieve.
+ * @return a pointer to the element if the position is valid, nullptr otherwise
+ */
+Object* AdaptiveList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	Object* retVal = _storage->Get(position);
+	if (retVal != nullptr){
+		Observe(ListStats::GET, position, 1.0, (position + 1.0) * LINK_COST);
+	}
+	return retVal;
+}
+/**
+ * Creates a string representation of the list, same format as the
+ * underlying storage. Example: {2, 6, 8}
+ * @return a string representation of the list
+ */
+string AdaptiveList::ToString()const{
+	return _storage->ToString();
+}
+/**
+ * Releases all the elements. The representation is kept, the next
+ * windows will decide if it is still the right one.
+ */
+void AdaptiveList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	_storage->Clear();
+	_size = 0;
+	_window.operations[ListStats::CLEAR]++;
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool AdaptiveList::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Memory usage breakdown
+ * The adaptive list itself is part of the container
+ * @return the bytes used by the list, its storage and its elements
+ */
+ListMemoryUsage AdaptiveList::MemoryUsage()const{
+	ListMemoryUsage retVal = _storage->MemoryUsage();
+	retVal.container += sizeof(AdaptiveList);
+	return retVal;
+}
+/**
+ * Forces the list into a representation, regardless of the workload
+ * @param representation the representation to use from now on
+ */
+void AdaptiveList::Migrate(Representation representation){
+	MoveStorage(representation);
+	_window = Workload();
+}
+/**
+ * Representation accessor
+ * @return whether the elements are in an array or a linked list
+ */
+AdaptiveList::Representation AdaptiveList::GetRepresentation()const{
+	return _representation;
+}
+/**
+ * Migrations accessor
+ * @return the number of times the list changed representation
+ */
+size_t AdaptiveList::GetMigrations()const{
+	return _migrations;
+}
+/**
+ * Workload accessor
+ * @return what has been observed in the current window
+ */
+AdaptiveList::Workload AdaptiveList::GetWorkload()const{
+	return _window;
+}
+/**
+ * Adds an operation to the current window. When the window is full it
+ * compares the cost of both representations and migrates only if the
+ * other one is cheaper by more than the hysteresis margin plus the cost
+ * of moving every element. The window starts over either way.
+ * @param operation the operation executed
+ * @param position the position it touched
+ * @param arrayCost what it costs in the array representation
+ * @param linkedCost what it costs in the linked representation
+ */
+void AdaptiveList::Observe(ListStats::Operation operation, size_t position, double arrayCost, double linkedCost)const{
+	size_t quarter = _size / 4;
+	if (position < quarter || _size == 0){
+		_window.positions[FRONT]++;
+	}else if (position + quarter >= _size){
+		_window.positions[BACK]++;
+	}else{
+		_window.positions[MIDDLE]++;
+	}
+	_window.operations[operation]++;
+	_window.arrayCost += arrayCost;
+	_window.linkedCost += linkedCost;
+
+	size_t observed = 0;
+	for (size_t op = 0; op < ListStats::OPERATION_COUNT; op++){
+		observed += _window.operations[op];
+	}
+	if (observed < WINDOW){
+		return;
+	}
+	double current = _representation == ARRAY ? _window.arrayCost : _window.linkedCost;
+	double other = _representation == ARRAY ? _window.linkedCost : _window.arrayCost;
+	if (other * (1.0 + HYSTERESIS) + _size * MIGRATION_COST < current){
+		MoveStorage(_representation == ARRAY ? LINKED : ARRAY);
+	}
+	_window = Workload();
+}
+/**
+ * Moves every element pointer into a new storage of the given
+ * representation. Elements are never cloned; the old storage is left
+ * empty before being deleted so it does not release them. Both loops
+ * only touch the ends of the lists so the migration is linear.
+ * @param representation the new representation
+ */
+void AdaptiveList::MoveStorage(Representation representation)const{
+	if (representation == _representation){
+		return;
+	}
+	List* moved = nullptr;
+	if (representation == LINKED){
+		moved = new DoubleLinkedList();
+		while (!_storage->IsEmpty()){
+			moved->Insert(_storage->Remove(_storage->Size() - 1), 0);
+		}
+	}else{
+		moved = new VSArray(_size > _capacity ? _size : _capacity, _delta);
+		while (!_storage->IsEmpty()){
+			moved->Insert(_storage->Remove(0), moved->Size());
+		}
+	}
+	delete _storage;
+	_storage = moved;
+	_representation = representation;
+	_migrations++;
+}
@@ -0,0 +1,100 @@
+/*
+ * Title:		Adaptive List
+ * Purpose:		Declaration of a list that keeps its elements in either a
+ * 				VSArray or a DoubleLinkedList and migrates between the two
+ * 				when the observed workload makes the other one cheaper
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef ADAPTIVE_LIST_H
+#define ADAPTIVE_LIST_H
+
+#include "object.h"
+#include "list.h"
+#include "vsarray.h"
+#include "dlinkedlist.h"
+
+#include <string>
+using std::string;
+
+class AdaptiveList final : public List{
+public:
+	enum Representation{
+		ARRAY,
+		LINKED
+	};
+	enum Region{
+		FRONT,		// First quarter of the list
+		MIDDLE,
+		BACK,		// Last quarter of the list
+		REGION_COUNT
+	};
+	/**
+	 * What the list observed during the current window of operations and
+	 * what those operations would have cost in each representation.
+	 */
+	struct Workload{
+		size_t operations[ListStats::OPERATION_COUNT];
+		size_t positions[REGION_COUNT];
+		double arrayCost;
+		double linkedCost;
+		Workload();
+	};
+	// Operations observed before deciding whether to migrate
+	static const size_t WINDOW = 64;
+	// The other representation has to be this much cheaper to migrate
+	static const double HYSTERESIS;
+	// Cost of moving one element pointer during a migration
+	static const double MIGRATION_COST;
+	// Extra cost of following a node link over reading an array slot
+	static const double LINK_COST;
+private:
+	// Mutable because Get and IndexOf are observed and may trigger a migration,
+	// which changes the storage but never the contents of the list
+	mutable List* _storage;
+	mutable Representation _representation;
+	size_t _capacity;
+	double _delta;
+	mutable Workload _window;
+	mutable size_t _migrations;
+	AdaptiveList(const AdaptiveList&);
+	const AdaptiveList& operator=(const AdaptiveList&);
+	void Observe(ListStats::Operation operation, size_t position, double arrayCost, double linkedCost)const;
+	void MoveStorage(Representation representation)const;
+public:
+	AdaptiveList(size_t capacity = 16, double increasePercentage = 0.5);
+	virtual ~AdaptiveList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+
+	void Migrate(Representation representation);
+	Representation GetRepresentation()const;
+	size_t GetMigrations()const;
+	Workload GetWorkload()const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+/**
+ * Visits the elements in order, dispatching once on the representation
+ * instead of once per element.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool AdaptiveList::Visit(Visitor visitor)const{
+	if (_representation == ARRAY){
+		return static_cast<const VSArray*>(_storage)->Visit(visitor);
+	}
+	return static_cast<const DoubleLinkedList*>(_storage)->Visit(visitor);
+}
+
+#endif
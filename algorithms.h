@@ -0,0 +1,133 @@
+/*
+ * Title:		List Algorithms
+ * Purpose:		Algorithms specialized on the concrete list type. They iterate
+ * 				with the list's Visit member template, so there is no virtual
+ * 				call per element to reach the element and the loop is inlined
+ * 				into the caller. The ...As variants also know the element type
+ * 				and hand the function a const Element&, letting the compiler
+ * 				inline the element accessors as well.
+ *
+ * 				Any list type with a Visit(visitor) member works: VSArray,
+ * 				DoubleLinkedList, IndexLinkedList, IntrusiveList, CowList,
+ * 				AdaptiveList, StaticArrayList, GapBufferList and SubList. Code
+ * 				that only has a List* keeps using the virtual List interface.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef LIST_ALGORITHMS_H
+#define LIST_ALGORITHMS_H
+
+#include "object.h"
+
+#include <cassert>
+
+/**
+ * Calls function(Object*) with every element, in order
+ */
+template <class ListType, class Function>
+void ForEach(const ListType& list, Function function){
+	list.Visit([&function](Object* element){
+		function(element);
+		return true;
+	});
+}
+/**
+ * Position of the first element for which predicate(const Object&) is true
+ * @return the position, -1 if there is none
+ */
+template <class ListType, class Predicate>
+int Find(const ListType& list, Predicate predicate){
+	int index = 0;
+	bool found = !list.Visit([&index, &predicate](Object* element){
+		if (predicate(*element)){
+			return false;
+		}
+		index++;
+		return true;
+	});
+	return found ? index : -1;
+}
+/**
+ * Folds the elements into a value, operation(accumulated, const Object&)
+ * returns the next accumulated value
+ */
+template <class ListType, class T, class Operation>
+T Accumulate(const ListType& list, T initial, Operation operation){
+	list.Visit([&initial, &operation](Object* element){
+		initial = operation(initial, *element);
+		return true;
+	});
+	return initial;
+}
+/**
+ * Appends function(const Object&) for every element of source to the end of
+ * destination, the function returns a newly allocated element. Stops at the
+ * first element destination refuses, that element is deleted.
+ * @return true if every element was appended
+ */
+template <class ListType, class DestinationType, class Function>
+bool Transform(const ListType& source, DestinationType& destination, Function function){
+	return source.Visit([&destination, &function](Object* element){
+		Object* transformed = function(*element);
+		if (!destination.Insert(transformed, destination.Size())){
+			delete transformed;
+			return false;
+		}
+		return true;
+	});
+}
+
+/**
+ * The element of a list whose element type is known. Checked in debug
+ * builds, release builds trust the caller.
+ */
+template <class Element>
+const Element& ElementAs(const Object* element){
+	assert(dynamic_cast<const Element*>(element) != nullptr);
+	return *static_cast<const Element*>(element);
+}
+/**
+ * ForEach over a list whose elements are all of type Element,
+ * function(const Element&)
+ */
+template <class Element, class ListType, class Function>
+void ForEachAs(const ListType& list, Function function){
+	list.Visit([&function](Object* element){
+		function(ElementAs<Element>(element));
+		return true;
+	});
+}
+/**
+ * Find over a list whose elements are all of type Element,
+ * predicate(const Element&)
+ */
+template <class Element, class ListType, class Predicate>
+int FindAs(const ListType& list, Predicate predicate){
+	return Find(list, [&predicate](const Object& element){
+		return predicate(ElementAs<Element>(&element));
+	});
+}
+/**
+ * Accumulate over a list whose elements are all of type Element,
+ * operation(accumulated, const Element&)
+ */
+template <class Element, class ListType, class T, class Operation>
+T AccumulateAs(const ListType& list, T initial, Operation operation){
+	return Accumulate(list, initial, [&operation](T accumulated, const Object& element){
+		return operation(accumulated, ElementAs<Element>(&element));
+	});
+}
+/**
+ * Position of the first element equal to key. Equals is called on the key
+ * with its static type, which is not a virtual call, and the elements may
+ * be of any type.
+ * @return the position, -1 if there is none
+ */
+template <class Element, class ListType>
+int FindEqual(const ListType& list, const Element& key){
+	return Find(list, [&key](const Object& element){
+		return key.Element::Equals(element);
+	});
+}
+
+#endif
@@ -0,0 +1,1356 @@
+/*
+ * Title:		List Benchmarks
+ * Purpose:		Performance regression suite for the list implementations.
+ * 				Runs fixed workloads at several sizes, prints the time per
+ * 				operation and compares it with a checked in baseline.
+ * 				Times are divided by a calibration loop (allocate, compare
+ * 				and delete Integers) so the baseline does not depend on the
+ * 				speed of the machine.
+ *
+ * 				list_benchmark [--baseline file] [--update file] [--refresh file]
+ * 				               [--tolerance t] [--counters]
+ *
+ * 				--baseline	compares with the baseline, fails on a regression
+ * 							that lasts for SUITE_RUNS runs
+ * 				--update	adds the metrics missing from the baseline, the
+ * 							others keep their values
+ * 				--refresh	writes the median of SUITE_RUNS runs of every
+ * 							metric as the new baseline
+ * 				--tolerance	allowed slowdown before failing, 0.5 = 50% slower
+ * 				--counters	also prints hardware counters per operation, the
+ * 							ones of this process only, not of the producers
+ * 							or the threads it starts
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "integer.h"
+#include "list.h"
+#include "vsarray.h"
+#include "dlinkedlist.h"
+#include "adaptivelist.h"
+#include "cowlist.h"
+#include "indexlinkedlist.h"
+#include "staticarraylist.h"
+#include "memoryresource.h"
+#include "recordloader.h"
+#include "editbatch.h"
+#include "person.h"
+#include "sharedlist.h"
+#include "parallel.h"
+#include "lrucache.h"
+#include "columnlist.h"
+#include "gapbufferlist.h"
+#include "perfcounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::map;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+// Results are written here so the measured loops are not optimized away
+volatile size_t sink = 0;
+
+struct Implementation{
+	const char* name;
+	List* (*create)();
+};
+
+struct Workload{
+	const char* name;
+	// Runs the workload on an empty list, returns nanoseconds and operations
+	double (*run)(List* list, size_t n, size_t& operations);
+};
+
+const size_t SIZES[] = {1000, 4000};
+const size_t REPETITIONS = 7;
+// Shared machines vary by 30% between runs on the short metrics, a metric
+// must exceed this in SUITE_RUNS runs against a median baseline to fail
+const double DEFAULT_TOLERANCE = 0.5;
+// Runs a metric gets to stay within the tolerance, and runs of a refresh
+const size_t SUITE_RUNS = 3;
+
+List* CreateVSArray(){ return new VSArray(16); }
+List* CreateDoubleLinkedList(){ return new DoubleLinkedList(); }
+List* CreateAdaptiveList(){ return new AdaptiveList(16); }
+List* CreateCowList(){ return new CowList(); }
+List* CreateIndexLinkedList(){ return new IndexLinkedList(16); }
+List* CreateStaticArrayList(){ return new StaticArrayList<4096>(); }	// Holds the largest size
+/**
+ * Name of a shared memory segment, a new one every time so a segment left by
+ * a crashed run is never reused
+ */
+string SharedName(){
+	static size_t created = 0;
+	stringstream retVal;
+	retVal << "/list-benchmark-" << getpid() << "-" << created++;
+	return retVal.str();
+}
+List* CreateSharedList(){ return SharedList::Create(SharedName(), 4096); }
+List* CreateColumnList(){ return new ColumnList(); }
+List* CreateGapBufferList(){ return new GapBufferList(16); }
+List* CreateFilteredVSArray(){
+	List* retVal = new VSArray(16);
+	retVal->EnableFilter();
+	return retVal;
+}
+List* CreateFilteredDoubleLinkedList(){
+	List* retVal = new DoubleLinkedList();
+	retVal->EnableFilter();
+	return retVal;
+}
+
+const Implementation IMPLEMENTATIONS[] = {
+	{"VSArray", CreateVSArray},
+	{"DoubleLinkedList", CreateDoubleLinkedList},
+	{"AdaptiveList", CreateAdaptiveList},
+	{"CowList", CreateCowList},
+	{"IndexLinkedList", CreateIndexLinkedList},
+	{"StaticArrayList", CreateStaticArrayList},
+	{"SharedList", CreateSharedList},
+	{"ColumnList", CreateColumnList},
+	{"GapBufferList", CreateGapBufferList},
+	{"FilteredVSArray", CreateFilteredVSArray},
+	{"FilteredDoubleLinkedList", CreateFilteredDoubleLinkedList},
+};
+
+/**
+ * Deterministic pseudo random positions, same sequence on every platform
+ * @param state the generator state, updated
+ * @param bound the exclusive upper bound
+ * @return a number in [0, bound)
+ */
+size_t NextRandom(unsigned long long& state, size_t bound){
+	state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return static_cast<size_t>((state >> 33) % bound);
+}
+
+// Hardware counters of the measured regions, nullptr without --counters
+PerfCounters* counters = nullptr;
+// Nanoseconds of the regions counted since the last Reset of the counters
+double counted = 0;
+
+/**
+ * Starts a measured region, and its hardware counters with --counters
+ * @return the time the region started
+ */
+Clock::time_point Start(){
+	if (counters != nullptr){
+		counters->Start();
+	}
+	return Clock::now();
+}
+/**
+ * Ends a measured region, or the calibration loop
+ * @param start the time the region started
+ * @return the nanoseconds since start
+ */
+double Elapsed(Clock::time_point start){
+	double retVal = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	if (counters != nullptr && counters->Running()){
+		counters->Stop();
+		counted += retVal;
+	}
+	return retVal;
+}
+
+void Fill(List* list, size_t n){
+	for (size_t i = 0; i < n; i++){
+		list->Insert(new Integer(static_cast<int>(i)), list->Size());
+	}
+}
+
+double InsertFront(List* list, size_t n, size_t& operations){
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < n; i++){
+		list->Insert(new Integer(static_cast<int>(i)), 0);
+	}
+	operations = n;
+	return Elapsed(start);
+}
+
+double InsertBack(List* list, size_t n, size_t& operations){
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < n; i++){
+		list->Insert(new Integer(static_cast<int>(i)), list->Size());
+	}
+	operations = n;
+	return Elapsed(start);
+}
+
+double InsertRandom(List* list, size_t n, size_t& operations){
+	unsigned long long state = 42;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < n; i++){
+		list->Insert(new Integer(static_cast<int>(i)), NextRandom(state, list->Size() + 1));
+	}
+	operations = n;
+	return Elapsed(start);
+}
+
+double Scan(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	size_t found = 0;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < n; i++){
+		found += list->Get(i) != nullptr;
+	}
+	double retVal = Elapsed(start);
+	sink += found;
+	operations = n;
+	return retVal;
+}
+
+double Search(List* list, size_t n, size_t& operations){
+	const size_t SEARCHES = 64;
+	Fill(list, n);
+	vector<Integer> keys;
+	for (size_t i = 0; i < SEARCHES; i++){
+		// Every other key is missing, a miss scans the whole list
+		keys.push_back(Integer(static_cast<int>(i % 2 == 0 ? i * (n / SEARCHES) : n + i)));
+	}
+	int positions = 0;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < SEARCHES; i++){
+		positions += list->IndexOf(&keys[i]);
+	}
+	sink += positions;
+	operations = SEARCHES;
+	return Elapsed(start);
+}
+
+double ClearList(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	Clock::time_point start = Start();
+	list->Clear();
+	operations = n;
+	return Elapsed(start);
+}
+
+const Workload WORKLOADS[] = {
+	{"insert_front", InsertFront},
+	{"insert_back", InsertBack},
+	{"insert_random", InsertRandom},
+	{"scan", Scan},
+	{"search", Search},
+	{"clear", ClearList},
+};
+
+// Allocators compared by the resource benchmarks, nullptr is plain new
+MemoryResource* CreateHeap(){ return nullptr; }
+MemoryResource* CreateMonotonicArena(){ return new MonotonicArena(64 * 1024); }
+MemoryResource* CreatePoolResource(){ return new PoolResource(); }
+
+struct Allocator{
+	const char* name;
+	MemoryResource* (*create)();
+};
+
+const Allocator ALLOCATORS[] = {
+	{"Heap", CreateHeap},
+	{"MonotonicArena", CreateMonotonicArena},
+	{"PoolResource", CreatePoolResource},
+};
+
+/**
+ * The whole life of a request-scoped list: builds a linked list whose
+ * nodes and elements come from the resource, destroys it and releases
+ * the resource
+ */
+double BuildAndDestroy(MemoryResource* resource, size_t n, size_t& operations){
+	Clock::time_point start = Start();
+	DoubleLinkedList* list = new DoubleLinkedList(resource == nullptr ? MemoryResource::Default() : resource);
+	for (size_t i = 0; i < n; i++){
+		int value = static_cast<int>(i);
+		list->Insert(resource == nullptr ? new Integer(value) : new (resource) Integer(value), list->Size());
+	}
+	delete list;
+	delete resource;
+	operations = n;
+	return Elapsed(start);
+}
+
+/**
+ * Records in the format of the tests, alternating persons and integers,
+ * each one appended at the end
+ */
+string Records(size_t n){
+	stringstream retVal;
+	for (size_t i = 0; i < n; i++){
+		if (i % 2 == 0){
+			retVal << "Name" << i % 97 << " " << i % 90 << " " << i << "\n";
+		}else{
+			retVal << i * 7 << " " << i << "\n";
+		}
+	}
+	return retVal.str();
+}
+
+/**
+ * Parses the records with stream extraction and inserts them one by one,
+ * the way the tests read them
+ */
+double LoadWithStreams(const string& text, List* list, size_t& operations){
+	Clock::time_point start = Start();
+	stringstream input(text);
+	string line, name;
+	size_t age, position, number;
+	while (std::getline(input, line)){
+		stringstream record(line);
+		if (record >> number >> position){
+			list->Insert(new Integer(static_cast<int>(number)), position);
+			continue;
+		}
+		record.clear();
+		record.str(line);
+		if (record >> name >> age >> position){
+			list->Insert(new Person(name, age), position);
+		}
+	}
+	operations = list->Size();
+	return Elapsed(start);
+}
+
+double LoadWithRecordLoader(const string& text, List* list, size_t& operations){
+	Clock::time_point start = Start();
+	stringstream input(text);
+	RecordLoader().Load(input, *list);
+	operations = list->Size();
+	return Elapsed(start);
+}
+
+struct Loader{
+	const char* name;
+	double (*run)(const string& text, List* list, size_t& operations);
+};
+
+const Loader LOADERS[] = {
+	{"iostream", LoadWithStreams},
+	{"RecordLoader", LoadWithRecordLoader},
+};
+
+// Bursts of scattered edits, half inserts and half removes
+const size_t BURSTS = 16;
+const size_t BURST_SIZE = 32;
+
+double EditSequential(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	unsigned long long state = 42;
+	Clock::time_point start = Start();
+	for (size_t burst = 0; burst < BURSTS; burst++){
+		for (size_t i = 0; i < BURST_SIZE; i++){
+			if (i % 2 == 0){
+				list->Insert(new Integer(static_cast<int>(i)), NextRandom(state, list->Size() + 1));
+			}else{
+				delete list->Remove(NextRandom(state, list->Size()));
+			}
+		}
+	}
+	operations = BURSTS * BURST_SIZE;
+	return Elapsed(start);
+}
+
+double EditBatched(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	unsigned long long state = 42;
+	Clock::time_point start = Start();
+	for (size_t burst = 0; burst < BURSTS; burst++){
+		EditBatch batch(*list);
+		for (size_t i = 0; i < BURST_SIZE; i++){
+			if (i % 2 == 0){
+				batch.Insert(new Integer(static_cast<int>(i)), NextRandom(state, batch.Size() + 1));
+			}else{
+				batch.Remove(NextRandom(state, batch.Size()));
+			}
+		}
+		batch.Apply(*list);
+		for (Object* element : batch.Removed()){
+			delete element;
+		}
+	}
+	operations = BURSTS * BURST_SIZE;
+	return Elapsed(start);
+}
+
+struct Editor{
+	const char* name;
+	double (*run)(List* list, size_t n, size_t& operations);
+};
+
+const Editor EDITORS[] = {
+	{"sequential", EditSequential},
+	{"batch", EditBatched},
+};
+
+// Sizes of the node locality benchmarks, the larger one does not fit in the caches
+const size_t LOCALITY_SIZES[] = {4000, 65536};
+const size_t PASSES = 8;
+
+/**
+ * A linked list whose nodes are far from each other: the elements are
+ * appended to many lists at random and the lists are concatenated, so
+ * consecutive nodes were not allocated next to each other
+ */
+DoubleLinkedList* Scattered(size_t n){
+	const size_t PARTS = 64;
+	unsigned long long state = 42;
+	DoubleLinkedList parts[PARTS];
+	for (size_t i = 0; i < n; i++){
+		DoubleLinkedList& part = parts[NextRandom(state, PARTS)];
+		part.Insert(new Integer(static_cast<int>(i)), part.Size());
+	}
+	DoubleLinkedList* retVal = new DoubleLinkedList();
+	for (DoubleLinkedList& part : parts){
+		retVal->Concat(part);
+	}
+	return retVal;
+}
+
+double Traverse(DoubleLinkedList* list, size_t& operations){
+	size_t count = 0;
+	Clock::time_point start = Start();
+	for (size_t pass = 0; pass < PASSES; pass++){
+		list->Visit([&count](Object*){
+			count++;
+			return true;
+		});
+	}
+	double retVal = Elapsed(start);
+	sink += count;
+	operations = PASSES * list->Size();
+	return retVal;
+}
+
+double SearchMissing(DoubleLinkedList* list, size_t& operations){
+	Integer key(-1);
+	int positions = 0;
+	Clock::time_point start = Start();
+	for (size_t pass = 0; pass < PASSES; pass++){
+		positions += list->IndexOf(&key);
+	}
+	double retVal = Elapsed(start);
+	sink += positions;
+	operations = PASSES * list->Size();
+	return retVal;
+}
+
+struct Traversal{
+	const char* name;
+	double (*run)(DoubleLinkedList* list, size_t& operations);
+};
+
+const Traversal TRAVERSALS[] = {
+	{"scan", Traverse},
+	{"search", SearchMissing},
+};
+
+// Deep copies, in the calling thread and split over PARALLEL_THREADS threads
+const size_t COPY_SIZES[] = {65536, 262144};
+const size_t PARALLEL_THREADS = 4;
+
+double CopyVSArray(size_t n, size_t threads, size_t& operations){
+	VSArray list(n);
+	Fill(&list, n);
+	Clock::time_point start = Start();
+	VSArray* copy = list.DeepCopy(threads);
+	double retVal = Elapsed(start);
+	delete copy;
+	operations = n;
+	return retVal;
+}
+
+double CopyDoubleLinkedList(size_t n, size_t threads, size_t& operations){
+	DoubleLinkedList list;
+	Fill(&list, n);
+	Clock::time_point start = Start();
+	DoubleLinkedList* copy = list.DeepCopy(threads);
+	double retVal = Elapsed(start);
+	delete copy;
+	operations = n;
+	return retVal;
+}
+
+struct Copier{
+	const char* name;
+	double (*run)(size_t n, size_t threads, size_t& operations);
+};
+
+const Copier COPIERS[] = {
+	{"VSArray", CopyVSArray},
+	{"DoubleLinkedList", CopyDoubleLinkedList},
+};
+
+/**
+ * Searches a list of alternating persons and integers for integers, every
+ * other key is missing
+ */
+double SearchMixedIntegers(List* list, size_t n, size_t& operations){
+	const size_t SEARCHES = 64;
+	for (size_t i = 0; i < n; i++){
+		Object* element = i % 2 == 0 ? static_cast<Object*>(new Person("Mixed", i)) : new Integer(static_cast<int>(i));
+		list->Insert(element, list->Size());
+	}
+	vector<Integer> keys;
+	for (size_t i = 0; i < SEARCHES; i++){
+		keys.push_back(Integer(static_cast<int>(i % 2 == 0 ? i * (n / SEARCHES) + 1 : n + i)));
+	}
+	int positions = 0;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < SEARCHES; i++){
+		positions += list->IndexOf(&keys[i]);
+	}
+	sink += positions;
+	operations = SEARCHES;
+	return Elapsed(start);
+}
+
+// Keys searched together, every other one is missing
+const size_t SEARCH_KEYS = 16;
+
+vector<Integer> SearchKeys(size_t n){
+	vector<Integer> retVal;
+	for (size_t i = 0; i < SEARCH_KEYS; i++){
+		retVal.push_back(Integer(static_cast<int>(i % 2 == 0 ? i * (n / SEARCH_KEYS) : n + i)));
+	}
+	return retVal;
+}
+
+double SearchSequential(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	vector<Integer> keys = SearchKeys(n);
+	int positions = 0;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < SEARCH_KEYS; i++){
+		positions += list->IndexOf(&keys[i]);
+	}
+	sink += positions;
+	operations = SEARCH_KEYS;
+	return Elapsed(start);
+}
+
+double SearchAny(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	vector<Integer> keys = SearchKeys(n);
+	const Object* pointers[SEARCH_KEYS];
+	for (size_t i = 0; i < SEARCH_KEYS; i++){
+		pointers[i] = &keys[i];
+	}
+	Clock::time_point start = Start();
+	vector<int> positions = list->IndexOfAny(pointers, SEARCH_KEYS);
+	double retVal = Elapsed(start);
+	sink += positions[0];
+	operations = SEARCH_KEYS;
+	return retVal;
+}
+
+const Workload SEARCHES[] = {
+	{"sequential", SearchSequential},
+	{"any", SearchAny},
+};
+
+// Edits made around the cursor, two inserts for every remove
+const size_t CURSOR_EDITS = 4096;
+
+/**
+ * Types and deletes around a cursor that starts in the middle of the list
+ * and wanders a few positions between edits
+ */
+double EditAtCursor(List* list, size_t n, size_t& operations){
+	Fill(list, n);
+	unsigned long long state = 42;
+	size_t cursor = n / 2;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < CURSOR_EDITS; i++){
+		cursor += NextRandom(state, 9);
+		cursor = cursor < 4 ? 0 : std::min(cursor - 4, list->Size());
+		if (i % 3 != 2){
+			list->Insert(new Integer(static_cast<int>(i)), cursor++);
+		}else if (cursor > 0){
+			delete list->Remove(--cursor);
+		}
+	}
+	operations = CURSOR_EDITS;
+	return Elapsed(start);
+}
+
+const Implementation CURSOR_LISTS[] = {
+	{"VSArray", CreateVSArray},
+	{"DoubleLinkedList", CreateDoubleLinkedList},
+	{"GapBufferList", CreateGapBufferList},
+};
+
+struct Mixed{
+	const char* name;
+	List* (*create)();
+};
+
+const Mixed MIXED[] = {
+	{"VSArray", CreateVSArray},
+	{"DoubleLinkedList", CreateDoubleLinkedList},
+	{"ColumnList", CreateColumnList},
+};
+
+// Records moved from PRODUCERS processes to this one
+const size_t TRANSFER_SIZES[] = {16384, 65536};
+const size_t PRODUCERS = 2;
+const size_t TRANSFER_BATCH = 256;
+
+/**
+ * Record i of a transfer, alternating persons and integers
+ */
+Object* TransferElement(size_t i){
+	if (i % 2 == 0){
+		return new Person("Producer", i % 90);
+	}
+	return new Integer(static_cast<int>(i * 7));
+}
+
+bool WriteAll(int descriptor, const char* data, size_t bytes){
+	while (bytes > 0){
+		ssize_t written = write(descriptor, data, bytes);
+		if (written <= 0){
+			return false;
+		}
+		data += written;
+		bytes -= written;
+	}
+	return true;
+}
+
+/**
+ * Producer process of the pipe transfer, writes the records [first, last)
+ * one per line: "name age" or "number". Writes up to PIPE_BUF bytes are
+ * atomic, the lines of the producers never mix.
+ */
+void ProducePipe(int descriptor, size_t first, size_t last){
+	char buffer[PIPE_BUF];
+	size_t used = 0;
+	bool written = true;
+	for (size_t i = first; written && i < last; i++){
+		Object* element = TransferElement(i);
+		if (used + 64 > sizeof(buffer)){
+			written = WriteAll(descriptor, buffer, used);
+			used = 0;
+		}
+		Person* person = dynamic_cast<Person*>(element);
+		if (person != nullptr){
+			used += snprintf(buffer + used, sizeof(buffer) - used, "%s %zu\n", person->GetName(), person->GetAge());
+		}else{
+			used += snprintf(buffer + used, sizeof(buffer) - used, "%d\n", static_cast<Integer*>(element)->GetValue());
+		}
+		delete element;
+	}
+	written = written && WriteAll(descriptor, buffer, used);
+	close(descriptor);
+	_exit(written ? 0 : 1);
+}
+
+/**
+ * Producer process of the shared transfer, appends the records [first, last)
+ * to the list, TRANSFER_BATCH records per lock like the pipe writes a
+ * buffer at a time
+ */
+void ProduceShared(const string& name, size_t first, size_t last){
+	SharedList* list = SharedList::Attach(name);
+	bool inserted = list != nullptr;
+	for (size_t i = first; inserted && i < last; ){
+		list->Lock();
+		for (size_t end = std::min(i + TRANSFER_BATCH, last); inserted && i < end; i++){
+			inserted = list->Insert(TransferElement(i), list->Size());
+		}
+		list->Unlock();
+	}
+	delete list;
+	_exit(inserted ? 0 : 1);
+}
+
+/**
+ * Waits for the producers that were not reaped yet, the reaped ones are
+ * set to 0
+ * @param producers the process ids, -1 for the ones fork could not start
+ * @param options 0 to block, WNOHANG to reap only the ones that exited
+ * @return false if a producer did not start or did not send all its records
+ */
+bool WaitProducers(pid_t* producers, int options = 0){
+	bool retVal = true;
+	for (size_t p = 0; p < PRODUCERS; p++){
+		if (producers[p] <= 0){
+			retVal = producers[p] == 0 && retVal;
+			continue;
+		}
+		int status = 0;
+		pid_t reaped = waitpid(producers[p], &status, options);
+		if (reaped == 0){
+			continue;
+		}
+		retVal = reaped == producers[p] && WIFEXITED(status) && WEXITSTATUS(status) == 0 && retVal;
+		producers[p] = 0;
+	}
+	return retVal;
+}
+
+/**
+ * The producers serialize the records to a pipe, this process parses them
+ * and appends them to a local list
+ */
+double TransferPipe(size_t n, size_t& operations){
+	VSArray list(16);
+	Clock::time_point start = Start();
+	int descriptors[2];
+	if (pipe(descriptors) != 0){
+		return 0;
+	}
+	pid_t producers[PRODUCERS];
+	for (size_t p = 0; p < PRODUCERS; p++){
+		producers[p] = fork();
+		if (producers[p] == 0){
+			close(descriptors[0]);
+			ProducePipe(descriptors[1], ParallelRangeStart(n, PRODUCERS, p), ParallelRangeStart(n, PRODUCERS, p + 1));
+		}
+	}
+	close(descriptors[1]);
+	char buffer[64 * 1024];
+	size_t pending = 0;
+	ssize_t count;
+	while ((count = read(descriptors[0], buffer + pending, sizeof(buffer) - pending)) > 0){
+		char* line = buffer;
+		char* end = buffer + pending + count;
+		char* newline;
+		while ((newline = static_cast<char*>(memchr(line, '\n', end - line))) != nullptr){
+			*newline = '\0';
+			char* space = strchr(line, ' ');
+			if (space != nullptr){
+				*space = '\0';
+				list.Insert(new Person(line, std::strtoul(space + 1, nullptr, 10)), list.Size());
+			}else{
+				list.Insert(new Integer(std::atoi(line)), list.Size());
+			}
+			line = newline + 1;
+		}
+		pending = end - line;
+		memmove(buffer, line, pending);
+	}
+	close(descriptors[0]);
+	bool complete = WaitProducers(producers) && list.Size() == n;
+	double retVal = Elapsed(start);
+	operations = complete ? n : 0;
+	return retVal;
+}
+
+/**
+ * The producers append the records to a shared list, this process removes
+ * them into a local list as they arrive
+ */
+double TransferShared(size_t n, size_t& operations){
+	VSArray list(16);
+	string name = SharedName();
+	SharedList* shared = SharedList::Create(name, n);
+	if (shared == nullptr){
+		return 0;
+	}
+	Clock::time_point start = Start();
+	pid_t producers[PRODUCERS];
+	for (size_t p = 0; p < PRODUCERS; p++){
+		producers[p] = fork();
+		if (producers[p] == 0){
+			ProduceShared(name, ParallelRangeStart(n, PRODUCERS, p), ParallelRangeStart(n, PRODUCERS, p + 1));
+		}
+	}
+	// A producer that failed or did not start never sends its records
+	bool complete = true;
+	while (list.Size() < n){
+		complete = WaitProducers(producers, WNOHANG) && complete;
+		bool exited = std::none_of(producers, producers + PRODUCERS, [](pid_t producer){
+			return producer > 0;
+		});
+		// Takes every record that arrived under one lock
+		shared->Lock();
+		Object* element;
+		while ((element = shared->Remove(0)) != nullptr){
+			list.Insert(element, list.Size());
+		}
+		shared->Unlock();
+		if (list.Size() < n){
+			if (!complete || exited){
+				break;
+			}
+			sched_yield();
+		}
+	}
+	complete = WaitProducers(producers) && complete && list.Size() == n;
+	double retVal = Elapsed(start);
+	delete shared;
+	operations = complete ? n : 0;
+	return retVal;
+}
+
+struct Transfer{
+	const char* name;
+	double (*run)(size_t n, size_t& operations);
+};
+
+const Transfer TRANSFERS[] = {
+	{"pipe", TransferPipe},
+	{"SharedList", TransferShared},
+};
+
+// Cache accesses with keys drawn from twice the capacity, about half miss
+const size_t CACHE_ACCESSES = 4096;
+
+/**
+ * The recency order kept by hand in a DoubleLinkedList of keys: IndexOf,
+ * Remove and Insert at the front on a hit, Insert and Remove of the tail on
+ * a miss
+ */
+double CacheWithList(size_t n, size_t& operations){
+	DoubleLinkedList keys;
+	unsigned long long state = 42;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < CACHE_ACCESSES; i++){
+		Integer key(static_cast<int>(NextRandom(state, 2 * n)));
+		int position = keys.IndexOf(&key);
+		if (position >= 0){
+			keys.Insert(keys.Remove(position), 0);
+			continue;
+		}
+		keys.Insert(key.Clone(), 0);
+		if (keys.Size() > n){
+			delete keys.Remove(keys.Size() - 1);
+		}
+	}
+	operations = CACHE_ACCESSES;
+	return Elapsed(start);
+}
+
+double CacheWithLruCache(size_t n, size_t& operations){
+	LruCache cache(n);
+	unsigned long long state = 42;
+	Clock::time_point start = Start();
+	for (size_t i = 0; i < CACHE_ACCESSES; i++){
+		Integer key(static_cast<int>(NextRandom(state, 2 * n)));
+		if (cache.Get(key) == nullptr){
+			cache.Put(key.Clone(), new Integer(key.GetValue()));
+		}
+	}
+	operations = CACHE_ACCESSES;
+	return Elapsed(start);
+}
+
+struct Cache{
+	const char* name;
+	double (*run)(size_t n, size_t& operations);
+};
+
+const Cache CACHES[] = {
+	{"DoubleLinkedList", CacheWithList},
+	{"LruCache", CacheWithLruCache},
+};
+
+/**
+ * The fastest sample is the one least disturbed by the rest of the
+ * machine, it is more stable between runs than the mean or the median.
+ */
+double Fastest(const vector<double>& values){
+	return *std::min_element(values.begin(), values.end());
+}
+
+/**
+ * Nanoseconds per element of a reference loop that does what lists do
+ * with their elements: allocate, store the pointer, compare through a
+ * virtual call and delete. It is sampled next to every workload so both
+ * see the same machine speed.
+ */
+double Calibrate(){
+	const size_t N = 4096;
+	Object** data = new Object*[N];
+	Integer key(-1);
+	size_t matches = 0;
+	Clock::time_point start = Clock::now();
+	for (size_t i = 0; i < N; i++){
+		data[i] = new Integer(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < N; i++){
+		matches += data[i]->Equals(key);
+	}
+	for (size_t i = 0; i < N; i++){
+		delete data[i];
+	}
+	double retVal = Elapsed(start) / N;
+	sink += matches;
+	delete[] data;
+	return retVal;
+}
+
+/**
+ * Reads a baseline file written by WriteBaseline. Only the flat
+ * "metrics" object is read, every "name": number pair in it.
+ */
+bool ReadBaseline(const string& path, map<string, double>& baseline){
+	std::ifstream file(path.c_str());
+	if (!file){
+		return false;
+	}
+	stringstream content;
+	content << file.rdbuf();
+	string text = content.str();
+	size_t position = text.find("\"metrics\"");
+	if (position == string::npos){
+		return false;
+	}
+	position = text.find('{', position);
+	while (position != string::npos){
+		size_t open = text.find('"', position);
+		size_t end = text.find('}', position);
+		if (open == string::npos || end < open){
+			break;
+		}
+		size_t close = text.find('"', open + 1);
+		size_t colon = text.find(':', close);
+		string name = text.substr(open + 1, close - open - 1);
+		baseline[name] = std::strtod(text.c_str() + colon + 1, nullptr);
+		position = colon + 1;
+	}
+	return true;
+}
+
+bool WriteBaseline(const string& path, const map<string, double>& results){
+	std::ofstream file(path.c_str());
+	if (!file){
+		return false;
+	}
+	file << "{\n  \"metrics\": {\n";
+	for (map<string, double>::const_iterator it = results.begin(); it != results.end(); ++it){
+		file << "    \"" << it->first << "\": " << std::setprecision(4) << it->second;
+		file << (std::next(it) == results.end() ? "\n" : ",\n");
+	}
+	file << "  }\n}\n";
+	return true;
+}
+
+/**
+ * Prints the hardware counts per operation of the samples of one metric.
+ * Every repetition runs the same operations, so the counts per operation
+ * are the counts per nanosecond times the sum of the nanoseconds per
+ * operation of the samples.
+ * @param counters the counts of the measured regions of every sample
+ * @param nanoseconds the time of those regions
+ * @param samples the nanoseconds per operation of every sample
+ */
+void PrintCounters(const PerfCounters& counters, double nanoseconds, const vector<double>& samples){
+	double perNanosecond = 0;
+	for (double sample : samples){
+		perNanosecond += sample;
+	}
+	perNanosecond = nanoseconds == 0 ? 0 : perNanosecond / nanoseconds;
+	stringstream line;
+	line << std::fixed << std::setprecision(2) << "   ";
+	for (size_t i = 0; i < PerfCounters::EVENTS; i++){
+		PerfCounters::Event event = static_cast<PerfCounters::Event>(i);
+		line << " " << PerfCounters::Name(event) << " ";
+		if (counters.Available(event)){
+			line << counters.Count(event) * perNanosecond;
+		}else{
+			line << "-";
+		}
+	}
+	double cycles = counters.Count(PerfCounters::CYCLES);
+	if (counters.Available(PerfCounters::CYCLES) && counters.Available(PerfCounters::INSTRUCTIONS) && cycles != 0){
+		line << " ipc " << counters.Count(PerfCounters::INSTRUCTIONS) / cycles;
+	}
+	cout << line.str() << endl;
+}
+
+/**
+ * Runs every benchmark once and prints the time per operation of each one
+ * @param results receives the metric of every benchmark, in units
+ * @return false if a benchmark could not run
+ */
+bool RunSuite(map<string, double>& results){
+	// Each metric is the fastest sample divided by the fastest calibration
+	auto record = [&results](const string& name, const vector<double>& samples, const vector<double>& calibration){
+		double perOperation = Fastest(samples);
+		double unit = Fastest(calibration);
+		results[name] = perOperation / unit;
+		cout << std::left << std::setw(56) << name << std::right << std::setw(12)
+			<< perOperation << " ns/op" << std::setw(10) << perOperation / unit << " units" << endl;
+		if (counters != nullptr){
+			PrintCounters(*counters, counted, samples);
+			counters->Reset();
+			counted = 0;
+		}
+	};
+	for (const Implementation& implementation : IMPLEMENTATIONS){
+		for (const Workload& workload : WORKLOADS){
+			for (size_t n : SIZES){
+				vector<double> samples, calibration;
+				for (size_t r = 0; r < REPETITIONS; r++){
+					calibration.push_back(Calibrate());
+					List* list = implementation.create();
+					size_t operations = 0;
+					double nanoseconds = workload.run(list, n, operations);
+					samples.push_back(nanoseconds / (operations == 0 ? 1 : operations));
+					delete list;
+				}
+				stringstream name;
+				name << implementation.name << "/" << workload.name << "/" << n;
+				record(name.str(), samples, calibration);
+			}
+		}
+	}
+	for (const Allocator& allocator : ALLOCATORS){
+		for (size_t n : SIZES){
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				size_t operations = 0;
+				double nanoseconds = BuildAndDestroy(allocator.create(), n, operations);
+				samples.push_back(nanoseconds / operations);
+			}
+			stringstream name;
+			name << "Resource/" << allocator.name << "/build_destroy/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+	for (const Loader& loader : LOADERS){
+		for (size_t n : SIZES){
+			string text = Records(n);
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				List* list = new VSArray(16);
+				size_t operations = 0;
+				double nanoseconds = loader.run(text, list, operations);
+				samples.push_back(nanoseconds / (operations == 0 ? 1 : operations));
+				delete list;
+			}
+			stringstream name;
+			name << "Loader/" << loader.name << "/load/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+
+	for (const Editor& editor : EDITORS){
+		for (size_t i = 0; i < 2; i++){
+			const Implementation& implementation = IMPLEMENTATIONS[i];
+			for (size_t n : SIZES){
+				vector<double> samples, calibration;
+				for (size_t r = 0; r < REPETITIONS; r++){
+					calibration.push_back(Calibrate());
+					List* list = implementation.create();
+					size_t operations = 0;
+					double nanoseconds = editor.run(list, n, operations);
+					samples.push_back(nanoseconds / operations);
+					delete list;
+				}
+				stringstream name;
+				name << "Edit/" << implementation.name << "/" << editor.name << "/" << n;
+				record(name.str(), samples, calibration);
+			}
+		}
+	}
+
+	for (bool defragment : {false, true}){
+		for (const Traversal& traversal : TRAVERSALS){
+			for (size_t n : LOCALITY_SIZES){
+				vector<double> samples, calibration;
+				for (size_t r = 0; r < REPETITIONS; r++){
+					calibration.push_back(Calibrate());
+					DoubleLinkedList* list = Scattered(n);
+					if (defragment){
+						list->Defragment();
+					}
+					size_t operations = 0;
+					double nanoseconds = traversal.run(list, operations);
+					samples.push_back(nanoseconds / operations);
+					delete list;
+				}
+				stringstream name;
+				name << "Locality/DoubleLinkedList/" << (defragment ? "defragmented" : "scattered") << "/"
+					<< traversal.name << "/" << n;
+				record(name.str(), samples, calibration);
+			}
+		}
+	}
+
+	for (const Copier& copier : COPIERS){
+		for (size_t threads : {static_cast<size_t>(1), PARALLEL_THREADS}){
+			for (size_t n : COPY_SIZES){
+				vector<double> samples, calibration;
+				for (size_t r = 0; r < REPETITIONS; r++){
+					calibration.push_back(Calibrate());
+					size_t operations = 0;
+					double nanoseconds = copier.run(n, threads, operations);
+					samples.push_back(nanoseconds / operations);
+				}
+				stringstream name;
+				name << "Copy/" << copier.name << "/" << (threads == 1 ? "serial" : "parallel") << "/" << n;
+				record(name.str(), samples, calibration);
+			}
+		}
+	}
+
+	for (const Workload& search : SEARCHES){
+		for (size_t i = 0; i < 2; i++){
+			const Implementation& implementation = IMPLEMENTATIONS[i];
+			for (size_t n : SIZES){
+				vector<double> samples, calibration;
+				for (size_t r = 0; r < REPETITIONS; r++){
+					calibration.push_back(Calibrate());
+					List* list = implementation.create();
+					size_t operations = 0;
+					double nanoseconds = search.run(list, n, operations);
+					samples.push_back(nanoseconds / operations);
+					delete list;
+				}
+				stringstream name;
+				name << "MultiSearch/" << implementation.name << "/" << search.name << "/" << n;
+				record(name.str(), samples, calibration);
+			}
+		}
+	}
+
+	for (const Implementation& implementation : CURSOR_LISTS){
+		for (size_t n : SIZES){
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				List* list = implementation.create();
+				size_t operations = 0;
+				double nanoseconds = EditAtCursor(list, n, operations);
+				samples.push_back(nanoseconds / operations);
+				delete list;
+			}
+			stringstream name;
+			name << "Cursor/" << implementation.name << "/edit/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+
+	for (const Mixed& mixed : MIXED){
+		for (size_t n : SIZES){
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				List* list = mixed.create();
+				size_t operations = 0;
+				double nanoseconds = SearchMixedIntegers(list, n, operations);
+				samples.push_back(nanoseconds / operations);
+				delete list;
+			}
+			stringstream name;
+			name << "Mixed/" << mixed.name << "/search_integer/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+
+	for (const Cache& cache : CACHES){
+		for (size_t n : SIZES){
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				size_t operations = 0;
+				double nanoseconds = cache.run(n, operations);
+				samples.push_back(nanoseconds / operations);
+			}
+			stringstream name;
+			name << "Cache/" << cache.name << "/access/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+
+	for (const Transfer& transfer : TRANSFERS){
+		for (size_t n : TRANSFER_SIZES){
+			vector<double> samples, calibration;
+			for (size_t r = 0; r < REPETITIONS; r++){
+				calibration.push_back(Calibrate());
+				size_t operations = 0;
+				double nanoseconds = transfer.run(n, operations);
+				if (operations == 0){
+					cerr << "Transfer through " << transfer.name << " failed" << endl;
+					return false;
+				}
+				samples.push_back(nanoseconds / operations);
+			}
+			stringstream name;
+			name << "Transfer/" << transfer.name << "/" << PRODUCERS << "_producers/" << n;
+			record(name.str(), samples, calibration);
+		}
+	}
+
+	return true;
+}
+/**
+ * Runs the suite again and keeps the faster value of every metric. A
+ * slowdown caused by the machine rarely lasts for several runs, a
+ * regression of the code does.
+ * @param results the metrics of the previous runs, updated
+ * @return false if a benchmark could not run
+ */
+bool RunAgain(map<string, double>& results){
+	map<string, double> again;
+	if (!RunSuite(again)){
+		return false;
+	}
+	for (map<string, double>::const_iterator it = again.begin(); it != again.end(); ++it){
+		map<string, double>::iterator previous = results.find(it->first);
+		if (previous == results.end() || it->second < previous->second){
+			results[it->first] = it->second;
+		}
+	}
+	return true;
+}
+/**
+ * Compares the metrics with the baseline
+ * @param results the metrics measured
+ * @param baseline the metrics expected
+ * @param tolerance the allowed slowdown, 0.5 = 50% slower
+ * @param print true to print the delta of every metric
+ * @return the number of metrics slower than the baseline by more than the tolerance
+ */
+size_t Compare(const map<string, double>& results, const map<string, double>& baseline, double tolerance, bool print){
+	size_t retVal = 0;
+	for (map<string, double>::const_iterator it = results.begin(); it != results.end(); ++it){
+		map<string, double>::const_iterator expected = baseline.find(it->first);
+		if (expected == baseline.end()){
+			if (print){
+				cout << std::left << std::setw(56) << it->first << " not in baseline" << endl;
+			}
+			continue;
+		}
+		double delta = (it->second - expected->second) / expected->second;
+		bool regressed = delta > tolerance;
+		retVal += regressed;
+		if (print){
+			cout << std::left << std::setw(56) << it->first << std::right << std::setw(10) << expected->second
+				<< " -> " << std::setw(10) << it->second << std::showpos << std::setw(10) << delta * 100
+				<< "%" << std::noshowpos << (regressed ? "  REGRESSION" : "") << endl;
+		}
+	}
+	return retVal;
+}
+
+int main(int argc, char* argv[]){
+	string baselinePath, updatePath, refreshPath;
+	double tolerance = DEFAULT_TOLERANCE;
+	bool sampleCounters = false;
+	for (int i = 1; i < argc; i++){
+		if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc){
+			baselinePath = argv[++i];
+		}else if (strcmp(argv[i], "--update") == 0 && i + 1 < argc){
+			updatePath = argv[++i];
+		}else if (strcmp(argv[i], "--refresh") == 0 && i + 1 < argc){
+			refreshPath = argv[++i];
+		}else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc){
+			tolerance = std::strtod(argv[++i], nullptr);
+		}else if (strcmp(argv[i], "--counters") == 0){
+			sampleCounters = true;
+		}else{
+			cerr << "usage: " << argv[0] << " [--baseline file] [--update file] [--refresh file] [--tolerance t] [--counters]" << endl;
+			return 2;
+		}
+	}
+
+	cout << std::fixed << std::setprecision(2);
+
+	PerfCounters perfCounters;
+	if (sampleCounters){
+		if (perfCounters.Available()){
+			counters = &perfCounters;
+		}else{
+			cerr << "Hardware counters unavailable (" << perfCounters.Error() << "), reporting times only" << endl;
+		}
+	}
+
+	map<string, double> results;
+	if (!RunSuite(results)){
+		return 2;
+	}
+	if (!refreshPath.empty()){
+		// A refreshed baseline keeps the median of several runs, a typical
+		// run and not the luckiest one
+		map<string, vector<double> > runs;
+		for (size_t run = 0; run < SUITE_RUNS; run++){
+			map<string, double> again;
+			if (run > 0 && !RunSuite(again)){
+				return 2;
+			}
+			const map<string, double>& measured = run == 0 ? results : again;
+			for (map<string, double>::const_iterator it = measured.begin(); it != measured.end(); ++it){
+				runs[it->first].push_back(it->second);
+			}
+		}
+		for (map<string, vector<double> >::iterator it = runs.begin(); it != runs.end(); ++it){
+			std::sort(it->second.begin(), it->second.end());
+			results[it->first] = it->second[it->second.size() / 2];
+		}
+	}
+
+	if (!updatePath.empty()){
+		// Only metrics new to the baseline are added, the others keep their values
+		map<string, double> updated;
+		ReadBaseline(updatePath, updated);
+		size_t added = 0;
+		for (map<string, double>::const_iterator it = results.begin(); it != results.end(); ++it){
+			added += updated.insert(*it).second;
+		}
+		if (!WriteBaseline(updatePath, updated)){
+			cerr << "Cannot write " << updatePath << endl;
+			return 2;
+		}
+		cout << added << " metric(s) added to " << updatePath << endl;
+	}
+	if (!refreshPath.empty()){
+		if (!WriteBaseline(refreshPath, results)){
+			cerr << "Cannot write " << refreshPath << endl;
+			return 2;
+		}
+		cout << "Baseline written to " << refreshPath << endl;
+	}
+	if (baselinePath.empty()){
+		return 0;
+	}
+
+	map<string, double> baseline;
+	if (!ReadBaseline(baselinePath, baseline)){
+		cerr << "Cannot read " << baselinePath << endl;
+		return 2;
+	}
+	size_t regressions = Compare(results, baseline, tolerance, false);
+	for (size_t run = 1; run < SUITE_RUNS && regressions != 0; run++){
+		cout << endl << regressions << " metric(s) beyond the tolerance, measuring again" << endl;
+		if (!RunAgain(results)){
+			return 2;
+		}
+		regressions = Compare(results, baseline, tolerance, false);
+	}
+	cout << endl << "Comparison with " << baselinePath << " (tolerance " << tolerance * 100 << "%)" << endl;
+	Compare(results, baseline, tolerance, true);
+	if (regressions != 0){
+		cout << regressions << " metric(s) regressed beyond the tolerance" << endl;
+		return 1;
+	}
+	cout << "No regressions" << endl;
+	return 0;
+}
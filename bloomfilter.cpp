@@ -0,0 +1,135 @@
+/*
+ * Title:		Bloom Filter
+ * Purpose:		Implementation of the membership filter. The HASHES bit
+ * 				positions of an element come from one hash by double hashing.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "bloomfilter.h"
+
+#include <sstream>
+using std::stringstream;
+
+/**
+ * Default Constructor
+ * Starts with every counter in zero
+ */
+FilterStats::FilterStats() : hits(0), misses(0), falsePositives(0), rebuilds(0){
+
+}
+/**
+ * Creates a string representation of the counters in JSON format
+ * @return a string with every counter
+ */
+string FilterStats::ToString()const{
+	stringstream retVal;
+	retVal << "{hits: " << hits << ", misses: " << misses << ", falsePositives: " << falsePositives
+		<< ", rebuilds: " << rebuilds << "}";
+	return retVal.str();
+}
+
+/**
+ * Spreads the bits of a hash, element hashes such as the value of an
+ * Integer are far from uniform
+ * @param hash the hash to mix
+ * @return the mixed hash
+ */
+static uint64_t Mix(uint64_t hash){
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+/**
+ * Constructor
+ * @param expected the number of elements the filter is sized for
+ */
+BloomFilter::BloomFilter(size_t expected) : _mask(0), _expected(0), _added(0), _removed(0), _invalid(false){
+	Reset(expected);
+}
+/**
+ * Records an element
+ * @param hash the Hash() of the element
+ */
+void BloomFilter::Add(size_t hash){
+	uint64_t mixed = Mix(hash);
+	uint64_t step = (mixed >> 32) | 1;
+	for (unsigned i = 0; i < HASHES; i++){
+		size_t bit = static_cast<size_t>(mixed + i * step) & _mask;
+		_bits[bit / 64] |= 1ULL << (bit % 64);
+	}
+	_added++;
+}
+/**
+ * Membership test
+ * @param hash the Hash() of the element
+ * @return false if no element with this hash was added, true if one may
+ * have been
+ */
+bool BloomFilter::MayContain(size_t hash)const{
+	uint64_t mixed = Mix(hash);
+	uint64_t step = (mixed >> 32) | 1;
+	for (unsigned i = 0; i < HASHES; i++){
+		size_t bit = static_cast<size_t>(mixed + i * step) & _mask;
+		if ((_bits[bit / 64] & (1ULL << (bit % 64))) == 0){
+			return false;
+		}
+	}
+	return true;
+}
+/**
+ * Forgets every element and resizes the filter
+ * @param expected the number of elements the filter is sized for
+ */
+void BloomFilter::Reset(size_t expected){
+	size_t bits = 64;
+	while (bits < expected * BITS_PER_ELEMENT){
+		bits *= 2;
+	}
+	_bits.assign(bits / 64, 0);
+	_mask = bits - 1;
+	_expected = expected;
+	_added = 0;
+	_removed = 0;
+	_invalid = false;
+}
+/**
+ * Records that an element left the list, its bits stay set
+ */
+void BloomFilter::NoteRemoval(){
+	_removed++;
+}
+/**
+ * Records that elements were added or removed without going through Add,
+ * the filter must be rebuilt before it is used again
+ */
+void BloomFilter::Invalidate(){
+	_invalid = true;
+}
+/**
+ * A rebuild is due when the filter may miss elements, when a quarter of
+ * what was added has been removed, or when it holds twice the elements it
+ * was sized for. The last two only cost precision, so they wait until
+ * they are worth a rebuild.
+ * @return true if the filter should be rebuilt before the next lookup
+ */
+bool BloomFilter::NeedsRebuild()const{
+	return _invalid || _removed * 4 > _added || _added > 2 * _expected;
+}
+/**
+ * Bit count accessor
+ * @return the number of bits of the filter
+ */
+size_t BloomFilter::GetBitCount()const{
+	return _mask + 1;
+}
+/**
+ * Memory footprint
+ * @return the bytes used by the filter object and its bits
+ */
+size_t BloomFilter::MemoryBytes()const{
+	return sizeof(BloomFilter) + _bits.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,59 @@
+/*
+ * Title:		Bloom Filter
+ * Purpose:		Declaration of the membership filter lists use to answer
+ * 				IndexOf with -1 without scanning. It is keyed on element
+ * 				hashes (Object::Hash) and never reports a present element as
+ * 				absent. Elements cannot be taken out of a Bloom filter, after
+ * 				removals it only gets less precise until it is rebuilt.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+/**
+ * What the filter of a list did for IndexOf
+ */
+struct FilterStats{
+	unsigned long long hits;			// Lookups answered by the filter, no scan
+	unsigned long long misses;			// Lookups the filter could not answer
+	unsigned long long falsePositives;	// Misses whose scan did not find the element
+	unsigned long long rebuilds;		// Times the filter was rebuilt from the elements
+	FilterStats();
+	string ToString()const;
+};
+
+class BloomFilter{
+	// About 1% false positives at the expected number of elements
+	static const size_t BITS_PER_ELEMENT = 10;
+	static const unsigned HASHES = 7;
+
+	vector<uint64_t> _bits;
+	size_t _mask;			// Number of bits - 1, the number of bits is a power of two
+	size_t _expected;
+	size_t _added;			// Elements added since the last reset
+	size_t _removed;		// Elements removed since the last reset
+	bool _invalid;			// The contents changed in a way that was not tracked
+public:
+	mutable FilterStats stats;
+
+	explicit BloomFilter(size_t expected = 1024);
+
+	void Add(size_t hash);
+	bool MayContain(size_t hash)const;
+	void Reset(size_t expected);
+	void NoteRemoval();
+	void Invalidate();
+	bool NeedsRebuild()const;
+	size_t GetBitCount()const;
+	size_t MemoryBytes()const;
+};
+
+#endif
@@ -0,0 +1,546 @@
+/*
+ * Title:		Column List
+ * Purpose:		Implementation of the list that keeps each element type in
+ * 				its own column. Inserts and removes shift the tags, the ranks
+ * 				and one column, like an array list does. Removed names stay
+ * 				in the pool until enough of it is garbage to compact it.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "columnlist.h"
+#include "integer.h"
+#include "person.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <typeinfo>
+using std::stringstream;
+
+/**
+ * Default Constructor
+ * Starts empty, the columns grow as elements are inserted
+ */
+ColumnList::ColumnList() : _garbage(0){
+
+}
+/**
+ * Destructor
+ * Deletes the objects of the object column and the materialized ones
+ */
+ColumnList::~ColumnList(){
+	ReleaseMaterialized();
+	for (Object* object : _objects){
+		delete object;
+	}
+}
+/**
+ * Column an element is stored in. Only Integer and Person themselves are
+ * encoded, their subclasses keep their type in the object column.
+ */
+ColumnList::Column ColumnList::ColumnOf(const Object* element){
+	if (element != nullptr && typeid(*element) == typeid(Integer)){
+		return INTEGER_COLUMN;
+	}
+	if (element != nullptr && typeid(*element) == typeid(Person)){
+		return PERSON_COLUMN;
+	}
+	return OBJECT_COLUMN;
+}
+/**
+ * Index in a column of the next element of that column at or after position,
+ * counts the tags on the shorter side of position
+ * @return the elements of the column before position
+ */
+uint32_t ColumnList::Rank(Column column, size_t position)const{
+	if (position < _size / 2){
+		return static_cast<uint32_t>(std::count(_tags.begin(), _tags.begin() + position, column));
+	}
+	return static_cast<uint32_t>(CountOf(column) - std::count(_tags.begin() + position, _tags.end(), column));
+}
+/**
+ * Position of an element of a column
+ * @param column the column
+ * @param rank the index of the element in the column
+ * @return the position in the list
+ */
+int ColumnList::PositionOf(Column column, size_t rank)const{
+	for (size_t i = rank; i < _size; i++){
+		if (_tags[i] == column && _ranks[i] == rank){
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+/**
+ * Inserts an element, the elements after it shift one position
+ * @param element the element, deleted once it is stored if it is an Integer
+ * or a Person, owned by the list otherwise
+ * @param position where the element goes
+ * @return false if the position is invalid, the element is kept then
+ */
+bool ColumnList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size){
+		return false;
+	}
+	Column column = ColumnOf(element);
+	const Person* person = column == PERSON_COLUMN ? static_cast<const Person*>(element) : nullptr;
+	size_t length = person != nullptr ? strlen(person->GetName()) : 0;
+	if (person != nullptr && _names.size() + length + 1 > UINT32_MAX){
+		CompactNames();
+		if (_names.size() + length + 1 > UINT32_MAX){
+			return false;
+		}
+	}
+	ReleaseMaterialized();
+	uint32_t rank = Rank(column, position);
+	LIST_STATS_ADD(shifts, _size - position);
+	if (column == INTEGER_COLUMN){
+		_integers.insert(_integers.begin() + rank, static_cast<Integer*>(element)->GetValue());
+	}else if (column == PERSON_COLUMN){
+		PersonRecord record = {person->GetAge(), static_cast<uint32_t>(_names.size()), static_cast<uint32_t>(length)};
+		_names.insert(_names.end(), person->GetName(), person->GetName() + length + 1);
+		_persons.insert(_persons.begin() + rank, record);
+	}else{
+		_objects.insert(_objects.begin() + rank, element);
+	}
+	_tags.insert(_tags.begin() + position, column);
+	_ranks.insert(_ranks.begin() + position, rank);
+	for (size_t i = position + 1; i <= _size; i++){
+		_ranks[i] += _tags[i] == column;
+	}
+	_size++;
+	_version++;
+	FilterAdd(element);
+	if (column != OBJECT_COLUMN){
+		delete element;
+	}
+	return true;
+}
+/**
+ * Position of the first element equal to element. Integers and persons are
+ * looked up in their column, the object column is scanned only when it is
+ * not empty.
+ * @return the position, -1 if there is none
+ */
+int ColumnList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (FilterExcludes(element)){
+		return -1;
+	}
+	int retVal = FirstOf(element);
+	if (retVal < 0){
+		FilterMissed();
+	}
+	return retVal;
+}
+/**
+ * IndexOf without the filter and the statistics, shared with IndexOfAny
+ * @return the position of the first element equal to element, -1 if there is none
+ */
+int ColumnList::FirstOf(const Object* element)const{
+	int retVal = -1;
+	Column column = ColumnOf(element);
+	if (column == INTEGER_COLUMN){
+		retVal = IndexOfInteger(static_cast<const Integer*>(element)->GetValue());
+	}else if (column == PERSON_COLUMN){
+		const Person* person = static_cast<const Person*>(element);
+		retVal = IndexOfPerson(person->GetName(), person->GetAge());
+	}
+	for (size_t i = 0; i < _objects.size(); i++){
+		if (_objects[i]->Equals(*element)){
+			int position = PositionOf(OBJECT_COLUMN, i);
+			retVal = retVal < 0 || position < retVal ? position : retVal;
+			break;
+		}
+	}
+	return retVal;
+}
+/**
+ * Removes an element, the elements after it shift one position
+ * @param position the element to remove
+ * @return the element, a new object for integers and persons, the caller
+ * owns it, nullptr if the position is invalid
+ */
+Object* ColumnList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	ReleaseMaterialized();
+	Column column = static_cast<Column>(_tags[position]);
+	uint32_t rank = _ranks[position];
+	LIST_STATS_ADD(shifts, _size - position - 1);
+	Object* retVal;
+	if (column == INTEGER_COLUMN){
+		retVal = new Integer(_integers[rank]);
+		_integers.erase(_integers.begin() + rank);
+	}else if (column == PERSON_COLUMN){
+		const PersonRecord& record = _persons[rank];
+		retVal = new Person(string(_names.data() + record.name, record.length), record.age);
+		_garbage += record.length + 1;
+		_persons.erase(_persons.begin() + rank);
+	}else{
+		retVal = _objects[rank];
+		_objects.erase(_objects.begin() + rank);
+	}
+	_tags.erase(_tags.begin() + position);
+	_ranks.erase(_ranks.begin() + position);
+	for (size_t i = position; i + 1 < _size; i++){
+		_ranks[i] -= _tags[i] == column;
+	}
+	_size--;
+	_version++;
+	FilterRemoved();
+	if (_garbage > COMPACT_GARBAGE && _garbage * 2 > _names.size()){
+		CompactNames();
+	}
+	return retVal;
+}
+/**
+ * Element accessor. Integers and persons are materialized the first time
+ * they are requested.
+ * @return the element at position, owned by the list and valid until the
+ * list changes, nullptr if the position is invalid
+ */
+Object* ColumnList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	if (position >= _size){
+		return nullptr;
+	}
+	if (_tags[position] == OBJECT_COLUMN){
+		return _objects[_ranks[position]];
+	}
+	if (_materialized.size() < _size){
+		_materialized.resize(_size, nullptr);
+	}
+	if (_materialized[position] == nullptr){
+		_materialized[position] = Materialize(position);
+	}
+	return _materialized[position];
+}
+/**
+ * Creates the object an integer or a person position holds
+ * @param position a position of the integer or the person column
+ * @return a new Integer or Person
+ */
+Object* ColumnList::Materialize(size_t position)const{
+	uint32_t rank = _ranks[position];
+	if (_tags[position] == INTEGER_COLUMN){
+		return new Integer(_integers[rank]);
+	}
+	const PersonRecord& record = _persons[rank];
+	return new Person(string(_names.data() + record.name, record.length), record.age);
+}
+/**
+ * Deletes the objects Get materialized, called before every change
+ */
+void ColumnList::ReleaseMaterialized(){
+	for (Object* object : _materialized){
+		delete object;
+	}
+	_materialized.clear();
+}
+/**
+ * String representation of the elements, {2, 6, 8}, integers and persons are
+ * written from their columns
+ */
+string ColumnList::ToString()const{
+	stringstream retVal;
+	retVal << "{";
+	for (size_t i = 0; i < _size; i++){
+		retVal << (i == 0 ? "" : ", ");
+		uint32_t rank = _ranks[i];
+		if (_tags[i] == INTEGER_COLUMN){
+			retVal << _integers[rank];
+		}else if (_tags[i] == PERSON_COLUMN){
+			retVal << "Person: {name: " << _names.data() + _persons[rank].name << ", age: " << _persons[rank].age << "}";
+		}else{
+			retVal << _objects[rank]->ToString();
+		}
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Deletes every element, the list is left empty
+ */
+void ColumnList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	FilterInvalidate();
+	ReleaseMaterialized();
+	for (Object* object : _objects){
+		delete object;
+	}
+	_tags.clear();
+	_ranks.clear();
+	_integers.clear();
+	_persons.clear();
+	_names.clear();
+	_objects.clear();
+	_garbage = 0;
+	_size = 0;
+	_version++;
+}
+/**
+ * The tags, the ranks, the columns and the live names are the storage,
+ * materialized objects are counted with the elements
+ * @return the bytes used by the list and its elements
+ */
+ListMemoryUsage ColumnList::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(ColumnList) + _materialized.capacity() * sizeof(Object*) + FilterBytes();
+	retVal.storage = _size * (sizeof(uint8_t) + sizeof(uint32_t)) + _integers.size() * sizeof(int) +
+		_persons.size() * sizeof(PersonRecord) + _names.size() - _garbage + _objects.size() * sizeof(Object*);
+	retVal.unused = (_tags.capacity() - _size) * sizeof(uint8_t) + (_ranks.capacity() - _size) * sizeof(uint32_t) +
+		(_integers.capacity() - _integers.size()) * sizeof(int) +
+		(_persons.capacity() - _persons.size()) * sizeof(PersonRecord) + _names.capacity() - _names.size() + _garbage +
+		(_objects.capacity() - _objects.size()) * sizeof(Object*);
+	for (Object* object : _objects){
+		retVal.elements += object->FootprintBytes();
+	}
+	for (Object* object : _materialized){
+		retVal.elements += object != nullptr ? object->FootprintBytes() : 0;
+	}
+	return retVal;
+}
+/**
+ * Visits the elements in order, the objects of the object column directly
+ * and the integers and persons as Get materializes them
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool ColumnList::Walk(ElementVisitor& visitor)const{
+	for (size_t i = 0; i < _size; i++){
+		Object* element = _tags[i] == OBJECT_COLUMN ? _objects[_ranks[i]] : Get(i);
+		if (!visitor.Visit(element)){
+			return false;
+		}
+	}
+	return true;
+}
+/**
+ * Checks if the list keeps a filter up to date
+ * @return true, hashes of stored elements match the materialized ones
+ */
+bool ColumnList::SupportsFilter()const{
+	return true;
+}
+/**
+ * Column accessor
+ * @param position a valid position
+ * @return the column that holds the element at position
+ */
+ColumnList::Column ColumnList::ColumnAt(size_t position)const{
+	return static_cast<Column>(_tags[position]);
+}
+/**
+ * Reads an integer without materializing it
+ * @param value set to the value of the integer at position
+ * @return false if the position is invalid or is not an integer
+ */
+bool ColumnList::IntegerAt(size_t position, int& value)const{
+	if (position >= _size || _tags[position] != INTEGER_COLUMN){
+		return false;
+	}
+	value = _integers[_ranks[position]];
+	return true;
+}
+/**
+ * Reads a person without materializing it
+ * @param name set to the name in the pool, valid until the list changes
+ * @param age set to the age
+ * @return false if the position is invalid or is not a person
+ */
+bool ColumnList::PersonAt(size_t position, const char*& name, size_t& age)const{
+	if (position >= _size || _tags[position] != PERSON_COLUMN){
+		return false;
+	}
+	const PersonRecord& record = _persons[_ranks[position]];
+	name = _names.data() + record.name;
+	age = record.age;
+	return true;
+}
+/**
+ * Scans the integer column only
+ * @return the position of the first integer with the value, -1 if there is none
+ */
+int ColumnList::IndexOfInteger(int value)const{
+	vector<int>::const_iterator found = std::find(_integers.begin(), _integers.end(), value);
+	return found == _integers.end() ? -1 : PositionOf(INTEGER_COLUMN, found - _integers.begin());
+}
+/**
+ * Scans the person column only, comparing the ages before the names
+ * @return the position of the first person with the name and the age, -1 if
+ * there is none
+ */
+int ColumnList::IndexOfPerson(const char* name, size_t age)const{
+	size_t length = strlen(name);
+	for (size_t i = 0; i < _persons.size(); i++){
+		if (IsPerson(_persons[i], _names.data(), name, length, age)){
+			return PositionOf(PERSON_COLUMN, i);
+		}
+	}
+	return -1;
+}
+/**
+ * Compares a person record with a name and an age, the ages first
+ * @param names the name pool of the record
+ * @param length the length of name
+ * @return true if the record holds the name and the age
+ */
+bool ColumnList::IsPerson(const PersonRecord& record, const char* names, const char* name, size_t length, size_t age){
+	return record.age == age && record.length == length && memcmp(names + record.name, name, length) == 0;
+}
+/**
+ * Answers IndexOf for several keys, each key scans only its column
+ * @param keys the keys, nullptr keys are never found
+ * @param count the number of keys
+ * @return the position of the first element equal to each key, -1 for the
+ * keys that are not in the list
+ */
+vector<int> ColumnList::IndexOfAny(const Object* const* keys, size_t count)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	vector<int> retVal(count, -1);
+	for (size_t i = 0; i < count; i++){
+		if (keys[i] != nullptr && !FilterExcludes(keys[i])){
+			retVal[i] = FirstOf(keys[i]);
+			if (retVal[i] < 0){
+				FilterMissed();
+			}
+		}
+	}
+	return retVal;
+}
+/**
+ * Number of elements equal to element, integers and persons are compared
+ * in their columns
+ * @return 0 if there is none
+ */
+size_t ColumnList::CountOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (element == nullptr || FilterExcludes(element)){
+		return 0;
+	}
+	int last;
+	size_t retVal = AllOf(*element, nullptr, last);
+	if (retVal == 0){
+		FilterMissed();
+	}
+	return retVal;
+}
+/**
+ * Position of the last element equal to element
+ * @return the position, -1 if there is none
+ */
+int ColumnList::LastIndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (element == nullptr || FilterExcludes(element)){
+		return -1;
+	}
+	int retVal;
+	if (AllOf(*element, nullptr, retVal) == 0){
+		FilterMissed();
+	}
+	return retVal;
+}
+/**
+ * Positions of every element equal to element
+ * @return the positions in increasing order, empty if there is none
+ */
+vector<size_t> ColumnList::FindAll(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	vector<size_t> retVal;
+	int last;
+	if (element != nullptr && !FilterExcludes(element) && AllOf(*element, &retVal, last) == 0){
+		FilterMissed();
+	}
+	return retVal;
+}
+/**
+ * Finds every element equal to a key in one pass over the tags. An Integer
+ * or a Person key is compared with the values of its column, any key is
+ * compared with the objects of the object column, as IndexOf does.
+ * @param key the key
+ * @param positions where the positions are added, unless it is nullptr
+ * @param last set to the last position, -1 if there is none
+ * @return the number of elements equal to the key
+ */
+size_t ColumnList::AllOf(const Object& key, vector<size_t>* positions, int& last)const{
+	Column column = ColumnOf(&key);
+	const Person* person = column == PERSON_COLUMN ? static_cast<const Person*>(&key) : nullptr;
+	int value = column == INTEGER_COLUMN ? static_cast<const Integer&>(key).GetValue() : 0;
+	size_t length = person != nullptr ? strlen(person->GetName()) : 0;
+	size_t retVal = 0;
+	last = -1;
+	for (size_t i = 0; i < _size; i++){
+		uint32_t rank = _ranks[i];
+		bool equal;
+		if (_tags[i] == OBJECT_COLUMN){
+			equal = _objects[rank]->Equals(key);
+		}else if (_tags[i] != column){
+			equal = false;
+		}else if (column == INTEGER_COLUMN){
+			equal = _integers[rank] == value;
+		}else{
+			equal = IsPerson(_persons[rank], _names.data(), person->GetName(), length, person->GetAge());
+		}
+		if (equal){
+			retVal++;
+			last = static_cast<int>(i);
+			if (positions != nullptr){
+				positions->push_back(i);
+			}
+		}
+	}
+	return retVal;
+}
+/**
+ * Size of a column
+ * @return the number of elements stored in the column
+ */
+size_t ColumnList::CountOf(Column column)const{
+	if (column == INTEGER_COLUMN){
+		return _integers.size();
+	}
+	return column == PERSON_COLUMN ? _persons.size() : _objects.size();
+}
+/**
+ * Copies the names of the persons to a new pool without the removed ones
+ */
+void ColumnList::CompactNames(){
+	vector<char> names;
+	names.reserve(_names.size() - _garbage);
+	for (PersonRecord& record : _persons){
+		const char* name = _names.data() + record.name;
+		record.name = static_cast<uint32_t>(names.size());
+		names.insert(names.end(), name, name + record.length + 1);
+	}
+	_names.swap(names);
+	_garbage = 0;
+}
+/**
+ * Hash of the element at a position, the same as the hash of the Integer or
+ * the Person it materializes to
+ */
+size_t ColumnList::HashAt(size_t position)const{
+	uint32_t rank = _ranks[position];
+	if (_tags[position] == INTEGER_COLUMN){
+		return std::hash<int>()(_integers[rank]);
+	}
+	if (_tags[position] == OBJECT_COLUMN){
+		return _objects[rank]->Hash();
+	}
+	return Person::HashOf(_names.data() + _persons[rank].name, _persons[rank].age);
+}
+/**
+ * Adds every element to the filter without materializing them
+ */
+void ColumnList::FillFilter()const{
+	for (size_t i = 0; i < _size; i++){
+		_filter->Add(HashAt(i));
+	}
+}
@@ -0,0 +1,92 @@
+/*
+ * Title:		Column List
+ * Purpose:		Declaration of a list of mixed Integer and Person elements that
+ * 				stores each type in its own column instead of one heap object
+ * 				per element. Integers are packed ints, persons are (age, name)
+ * 				records whose names live in one shared string pool, and any
+ * 				other object is kept as a pointer. A tag per position says
+ * 				which column holds the element, and a rank per position says
+ * 				where in that column. Each column keeps the list order of its
+ * 				elements.
+ *
+ * 				Insert stores an Integer or a Person in its column and deletes
+ * 				it. Get materializes an object owned by the list that is valid
+ * 				until the list changes, changes to it are not seen by the
+ * 				list. Remove materializes an object owned by the caller.
+ * 				IndexOf of an Integer or a Person scans only its column, the
+ * 				other queries compare the keys with the columns without
+ * 				materializing the elements.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef COLUMN_LIST_H
+#define COLUMN_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+class ColumnList final : public List{
+public:
+	enum Column : uint8_t {INTEGER_COLUMN, PERSON_COLUMN, OBJECT_COLUMN};
+	static const size_t COMPACT_GARBAGE = 4096;	// Pool bytes freed before the pool is compacted
+private:
+	struct PersonRecord{
+		uint64_t age;
+		uint32_t name;		// Offset of the name in the pool
+		uint32_t length;	// Characters of the name, without the terminator
+	};
+	vector<uint8_t> _tags;			// Column of every position
+	vector<uint32_t> _ranks;		// Index of every position in its column
+	vector<int> _integers;
+	vector<PersonRecord> _persons;
+	vector<char> _names;			// Names of the persons, NUL terminated
+	size_t _garbage;				// Pool bytes of removed names
+	vector<Object*> _objects;
+	mutable vector<Object*> _materialized;	// Objects returned by Get, by position
+	ColumnList(const ColumnList&);
+	const ColumnList& operator=(const ColumnList&);
+	virtual void FillFilter()const;
+	static Column ColumnOf(const Object* element);
+	uint32_t Rank(Column column, size_t position)const;
+	int PositionOf(Column column, size_t rank)const;
+	int FirstOf(const Object* element)const;
+	size_t AllOf(const Object& key, vector<size_t>* positions, int& last)const;
+	static bool IsPerson(const PersonRecord& record, const char* names, const char* name, size_t length, size_t age);
+	Object* Materialize(size_t position)const;
+	void ReleaseMaterialized();
+	void CompactNames();
+	size_t HashAt(size_t position)const;
+public:
+	ColumnList();
+	virtual ~ColumnList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+	virtual vector<int> IndexOfAny(const Object* const* keys, size_t count)const;
+	virtual size_t CountOf(const Object* element)const;
+	virtual int LastIndexOf(const Object* element)const;
+	virtual vector<size_t> FindAll(const Object* element)const;
+
+	Column ColumnAt(size_t position)const;
+	bool IntegerAt(size_t position, int& value)const;
+	bool PersonAt(size_t position, const char*& name, size_t& age)const;
+	int IndexOfInteger(int value)const;
+	int IndexOfPerson(const char* name, size_t age)const;
+	size_t CountOf(Column column)const;
+};
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ * Title:		Copy-On-Write List
+ * Purpose:		Implementation of a list with constant time snapshots. The
+ * 				list is a table of chunks of up to CHUNK elements. A snapshot
+ * 				shares the table; the first modification copies the table
+ * 				(one pointer per chunk) and then only the chunk that is being
+ * 				modified. Copying a chunk copies element pointers and
+ * 				increments their reference counts, elements are never cloned
+ * 				unless a shared element is removed.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "cowlist.h"
+
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+/**
+ * Constructor
+ * Wraps an element with a single reference
+ * @param element the element being shared
+ */
+CowList::Shared::Shared(Object* element) : object(element), references(1){
+
+}
+/**
+ * Default Constructor
+ * An empty chunk
+ */
+CowList::Chunk::Chunk() : count(0){
+
+}
+/**
+ * Copy Constructor
+ * Shares every element of the other chunk
+ * @param other the chunk being copied
+ */
+CowList::Chunk::Chunk(const Chunk& other) : count(other.count){
+	for (size_t i = 0; i < count; i++){
+		items[i] = other.items[i];
+		items[i]->references++;
+	}
+}
+/**
+ * Destructor
+ * Drops this chunk's reference to each of its elements
+ */
+CowList::Chunk::~Chunk(){
+	for (size_t i = 0; i < count; i++){
+		Release(items[i]);
+	}
+}
+/**
+ * Default Constructor
+ * An empty list with an empty table
+ */
+CowList::CowList() : _table(std::make_shared<Table>()){
+
+}
+/**
+ * Copy Constructor
+ * Shares the table of the other list, used to take snapshots
+ * @param other the list being shared
+ */
+CowList::CowList(const CowList& other) : _table(other._table){
+	_size = other._size;
+}
+/**
+ * Destructor
+ * Chunks and elements are released when their last owner goes away
+ */
+CowList::~CowList(){
+
+}
+/**
+ * Inserts an element into a given position.
+ * Only the chunk that receives the element is copied if it was shared.
+ * A full chunk is split in two halves before inserting.
+ * @param element what the client wants to insert into the list
+ * @param position the position where the element is to be inserted
+ * @return true if it was possible to insert, false if the position is invalid
+ */
+bool CowList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size){
+		return false;
+	}
+	if (_table.use_count() > 1){
+		_table = std::make_shared<Table>(*_table);
+	}
+	size_t chunkIndex = 0;
+	size_t offset = 0;
+	if (_table->empty()){
+		_table->push_back(std::make_shared<Chunk>());
+	}else if (!Locate(position, chunkIndex, offset)){
+		// Appending, goes at the end of the last chunk
+		chunkIndex = _table->size() - 1;
+		offset = (*_table)[chunkIndex]->count;
+	}
+	Chunk* chunk = Writable(chunkIndex);
+	if (chunk->count == CHUNK){
+		std::shared_ptr<Chunk> half = std::make_shared<Chunk>();
+		half->count = CHUNK / 2;
+		for (size_t i = 0; i < half->count; i++){
+			half->items[i] = chunk->items[CHUNK / 2 + i];
+		}
+		chunk->count = CHUNK / 2;
+		_table->insert(_table->begin() + chunkIndex + 1, half);
+		if (offset > CHUNK / 2){
+			chunk = half.get();
+			offset -= CHUNK / 2;
+		}
+	}
+	LIST_STATS_ADD(shifts, chunk->count - offset);
+	for (size_t i = chunk->count; i > offset; i--){
+		chunk->items[i] = chunk->items[i - 1];
+	}
+	chunk->items[offset] = new Shared(element);
+	chunk->count++;
+	_size++;
+	return true;
+}
+/**
+ * Searches for the position of an element in the list, chunk by chunk.
+ * @param element the object that the client is searching for.
+ * @return the position of the element if found, -1 otherwise.
+ */
+int CowList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	size_t index = 0;
+	for (size_t c = 0; c < _table->size(); c++){
+		const Chunk* chunk = (*_table)[c].get();
+		for (size_t i = 0; i < chunk->count; i++){
+			if (chunk->items[i]->object->Equals(*element)){
+				return index + i;
+			}
+		}
+		index += chunk->count;
+	}
+	return -1;
+}
+/**
+ * Removes the element at position, when the position is valid.
+ * The caller owns the returned element. If a snapshot still holds the
+ * element the snapshot keeps the original and the caller gets a clone.
+ * @param position the position of the element to be removed.
+ * @return the removed element if the position was valid, nullptr otherwise
+ */
+Object* CowList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	if (_table.use_count() > 1){
+		_table = std::make_shared<Table>(*_table);
+	}
+	size_t chunkIndex = 0;
+	size_t offset = 0;
+	Locate(position, chunkIndex, offset);
+	Chunk* chunk = Writable(chunkIndex);
+	Shared* item = chunk->items[offset];
+	LIST_STATS_ADD(shifts, chunk->count - offset - 1);
+	for (size_t i = offset; i < chunk->count - 1; i++){
+		chunk->items[i] = chunk->items[i + 1];
+	}
+	chunk->count--;
+	if (chunk->count == 0){
+		_table->erase(_table->begin() + chunkIndex);
+	}
+	_size--;
+
+	Object* retVal = nullptr;
+	if (item->references == 1){
+		// Only this list held it, no other list can acquire it now
+		retVal = item->object;
+		delete item;
+	}else{
+		retVal = item->object->Clone();
+		Release(item);
+	}
+	return retVal;
+}
+/**
+ * Element Access
+ * Returns the element at a given position, it is not a copy. While
+ * snapshots exist the element is shared with them and should not be
+ * modified.
+ * @param position the position of the element to retrieve.
+ * @return a pointer to the element if the position is valid, nullptr otherwise
+ */
+Object* CowList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	size_t chunkIndex = 0;
+	size_t offset = 0;
+	if (!Locate(position, chunkIndex, offset)){
+		return nullptr;
+	}
+	return (*_table)[chunkIndex]->items[offset]->object;
+}
+/**
+ * Creates a string representation of the list. This representation
+ * will be the string representation of each of the elements, surrounding
+ * the whole list with curly braces and separating the elements by comma.
+ * Example: {2, 6, 8}
+ * @return a string representation of the list
+ */
+string CowList::ToString()const{
+	stringstream retVal;
+	retVal << "{";
+	size_t written = 0;
+	for (size_t c = 0; c < _table->size(); c++){
+		const Chunk* chunk = (*_table)[c].get();
+		for (size_t i = 0; i < chunk->count; i++){
+			retVal << (written++ == 0 ? "" : ", ") << chunk->items[i]->object->ToString();
+		}
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Makes the list empty. Elements still held by a snapshot survive, the
+ * rest are released.
+ */
+void CowList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	_table = std::make_shared<Table>();
+	_size = 0;
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool CowList::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Memory usage breakdown
+ * Storage is the chunk slots in use plus the reference counted cells,
+ * shared chunks are counted in full by every list that holds them.
+ * @return the bytes used by the list, its chunks and its elements
+ */
+ListMemoryUsage CowList::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(CowList) + sizeof(Table) + _table->capacity() * sizeof(std::shared_ptr<Chunk>);
+	for (size_t c = 0; c < _table->size(); c++){
+		const Chunk* chunk = (*_table)[c].get();
+		retVal.storage += sizeof(Chunk) - CHUNK * sizeof(Shared*) + chunk->count * (sizeof(Shared*) + sizeof(Shared));
+		retVal.unused += (CHUNK - chunk->count) * sizeof(Shared*);
+		for (size_t i = 0; i < chunk->count; i++){
+			retVal.elements += chunk->items[i]->object->FootprintBytes();
+		}
+	}
+	return retVal;
+}
+/**
+ * Creates a snapshot of the list in constant time. The snapshot is a
+ * regular CowList that shares the storage, it does not see later changes
+ * to this list and this list does not see changes to the snapshot.
+ * @return a newly allocated list, the caller must delete it
+ */
+CowList* CowList::Snapshot()const{
+	return new CowList(*this);
+}
+/**
+ * Checks if two lists still share their whole storage, which is the case
+ * between a snapshot and its origin until one of them is modified.
+ * @param other the other list
+ * @return true if both lists use the same table of chunks
+ */
+bool CowList::Shares(const CowList& other)const{
+	return _table == other._table;
+}
+/**
+ * Finds the chunk and the offset inside the chunk of a position
+ * @param position the position of the element
+ * @param chunk where the index of the chunk is stored
+ * @param offset where the offset inside the chunk is stored
+ * @return true if the position is valid, false otherwise
+ */
+bool CowList::Locate(size_t position, size_t& chunk, size_t& offset)const{
+	if (position >= _size){
+		return false;
+	}
+	for (chunk = 0; position >= (*_table)[chunk]->count; chunk++){
+		position -= (*_table)[chunk]->count;
+	}
+	offset = position;
+	return true;
+}
+/**
+ * Makes a chunk private to this list before modifying it, copying it if
+ * it is shared. The table must already be private.
+ * @param chunk the index of the chunk
+ * @return the chunk that can be modified
+ */
+CowList::Chunk* CowList::Writable(size_t chunk){
+	std::shared_ptr<Chunk>& slot = (*_table)[chunk];
+	if (slot.use_count() > 1){
+		slot = std::make_shared<Chunk>(*slot);
+	}
+	return slot.get();
+}
+/**
+ * Drops one reference to a shared element, deleting it with the last one
+ * @param item the shared element
+ */
+void CowList::Release(Shared* item){
+	if (--item->references == 0){
+		delete item->object;
+		delete item;
+	}
+}
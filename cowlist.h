@@ -0,0 +1,91 @@
+/*
+ * Title:		Copy-On-Write List
+ * Purpose:		Declaration of a list whose snapshots are taken in constant
+ * 				time. The elements live in reference counted chunks that are
+ * 				shared between a list and its snapshots, a chunk is copied
+ * 				only when one of them modifies it.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef COW_LIST_H
+#define COW_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+using std::string;
+
+class CowList final : public List{
+public:
+	// Maximum number of elements in a chunk, the unit of copying
+	static const size_t CHUNK = 512;
+private:
+	/**
+	 * An element shared by several chunks, it is deleted when the last
+	 * chunk that holds it is destroyed.
+	 */
+	struct Shared{
+		Object* object;
+		std::atomic<size_t> references;
+		explicit Shared(Object* element);
+	};
+	struct Chunk{
+		Shared* items[CHUNK];
+		size_t count;
+		Chunk();
+		Chunk(const Chunk& other);
+		~Chunk();
+	private:
+		const Chunk& operator=(const Chunk&);
+	};
+	typedef std::vector<std::shared_ptr<Chunk> > Table;
+	std::shared_ptr<Table> _table;
+
+	CowList(const CowList& other);
+	const CowList& operator=(const CowList&);
+	bool Locate(size_t position, size_t& chunk, size_t& offset)const;
+	Chunk* Writable(size_t chunk);
+	static void Release(Shared* item);
+public:
+	CowList();
+	virtual ~CowList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+
+	CowList* Snapshot()const;
+	bool Shares(const CowList& other)const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+/**
+ * Visits the elements in order, chunk by chunk, without virtual dispatch.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool CowList::Visit(Visitor visitor)const{
+	for (size_t c = 0; c < _table->size(); c++){
+		const Chunk* chunk = (*_table)[c].get();
+		for (size_t i = 0; i < chunk->count; i++){
+			if (!visitor(chunk->items[i]->object)){
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+#endif
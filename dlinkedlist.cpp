@@ -6,8 +6,14 @@
  */
 #include "object.h"
 #include "dlinkedlist.h"
+#include "reclaimer.h"
+#include "memoryresource.h"
+#include "editbatch.h"
+#include "parallel.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <sstream>
 
@@ -21,8 +27,10 @@ using std::stringstream;
 /**
  * Default constructor
  * Just sets the head and tail to nullptr
+ * @param resource where the nodes are allocated
  */
-DoubleLinkedList::DoubleLinkedList() : _head(nullptr), _tail(nullptr){}
+DoubleLinkedList::DoubleLinkedList(MemoryResource* resource) : _head(nullptr), _tail(nullptr), _resource(resource),
+    _block(nullptr), _blockSize(0), _spare(nullptr), _spareCount(0), _defragmentThreshold(0), _churn(0){}
 
 /**
  * Copy Constructor
@@ -31,9 +39,11 @@ DoubleLinkedList::DoubleLinkedList() : _head(nullptr), _tail(nullptr){}
  * this insertion is done using the Insert method.
  * @param DoubleLinkedList &other
  */
-DoubleLinkedList::DoubleLinkedList(const DoubleLinkedList &other) : _head(nullptr){
+DoubleLinkedList::DoubleLinkedList(const DoubleLinkedList &other) : _head(nullptr), _tail(nullptr),
+    _resource(other._resource), _block(nullptr), _blockSize(0), _spare(nullptr), _spareCount(0),
+    _defragmentThreshold(other._defragmentThreshold), _churn(0){
     for (Node* tmp = other._head; tmp != nullptr; tmp = tmp->next){
-        Insert(tmp->data->Clone(), _size);
+        Insert(tmp->data->Clone(_resource), _size);
     }
 }
 
@@ -48,7 +58,7 @@ DoubleLinkedList::DoubleLinkedList(const DoubleLinkedList &other) : _head(nullpt
  */
 DoubleLinkedList &DoubleLinkedList::operator=(const DoubleLinkedList &rhs) {
     for (Node* tmp = rhs._head; tmp != nullptr; tmp = tmp->next){
-        Insert(tmp->data->Clone(), _size);
+        Insert(tmp->data->Clone(_resource), _size);
     } // Sets elements equal to rhs
 	return *this;
 }
@@ -60,14 +70,18 @@ DoubleLinkedList &DoubleLinkedList::operator=(const DoubleLinkedList &rhs) {
  * then its node.
  */
 DoubleLinkedList::~DoubleLinkedList() {
+    if (Defer()){
+        return;
+    }
     Node* tempNode = _head;
     while (_head != nullptr){
         _head = tempNode->next;
         if (tempNode->data)
             delete tempNode->data;
-        delete tempNode;
+        DeleteNode(tempNode);
         tempNode = _head;
     }
+    ReleaseBlock();
 }
 
 /**
@@ -80,13 +94,14 @@ DoubleLinkedList::~DoubleLinkedList() {
  * to insert if the position is invalid.
  */
 bool DoubleLinkedList::Insert(Object *element, size_t position) {
+    LIST_STATS_SCOPE(INSERT);
 
     // If position is valid
     if (position > _size){
         return false;
     }
 
-    Node* neo = new Node();  // Allocate memory for new node, 'neo'
+    Node* neo = NewNode();   // Allocate memory for new node, 'neo'
     neo->data = element;     // Assign data to neo
     neo->next = nullptr;     // Next ptr, null by default
     neo->previous = nullptr; // Previous ptr, null by default
@@ -107,7 +122,7 @@ bool DoubleLinkedList::Insert(Object *element, size_t position) {
         neo->next = _head;     // Assigns next of neo to _head
         _head->previous = neo; // Assigns previous of head to neo;
         _head = neo;             // Assigns _head to neo
-    } else if (position == _size - 1) {
+    } else if (position == _size) {
         /* --- INSERT NODE AFTER TAIL
          *  the list's head pointer is not null (list is not empty) and curNode
          *  points to the list's tail node, the new node is inserted after the tail node.
@@ -141,6 +156,7 @@ bool DoubleLinkedList::Insert(Object *element, size_t position) {
         for (size_t i = 0; i < position - 1; i++){
             tmp = tmp -> next;
         }
+        LIST_STATS_ADD(hops, position - 1);
 
         /* [ 1 ] */ neo -> next = tmp -> next; // Assign next of neo equal to next of previous node
         /* [ 2 ] */ neo -> previous = tmp;     // Assign previous of neo to previous node
@@ -149,6 +165,141 @@ bool DoubleLinkedList::Insert(Object *element, size_t position) {
             /* [ 4 ] */ neo -> next -> previous = neo; // Assign previous of node next to neo, to neo
     }
     _size++;
+    _version++;
+    FilterAdd(element);
+    Churn(1);
+    return true;
+}
+
+/**
+ * InsertRange()
+ * Links a run of new nodes into the list with a single walk to position.
+ * @param elements the elements to insert, the list owns them afterwards
+ * @param count the number of elements
+ * @param position where the first element goes
+ * @return count, or 0 if the position is invalid
+ */
+size_t DoubleLinkedList::InsertRange(Object* const* elements, size_t count, size_t position) {
+    LIST_STATS_SCOPE(INSERT);
+    if (position > _size){
+        return 0;
+    }
+    if (count == 0){
+        return 0;
+    }
+
+    // Builds the run of nodes first, then links it as a whole
+    Node* runFirst = nullptr;
+    Node* runLast = nullptr;
+    for (size_t i = 0; i < count; i++){
+        Node* neo = NewNode();
+        neo->data = elements[i];
+        neo->next = nullptr;
+        neo->previous = runLast;
+        if (runLast == nullptr){
+            runFirst = neo;
+        } else {
+            runLast->next = neo;
+        }
+        runLast = neo;
+        FilterAdd(elements[i]);
+    }
+
+    Node* successor = position == _size ? nullptr : NodeAt(position);
+    Node* predecessor = successor == nullptr ? _tail : successor->previous;
+    runFirst->previous = predecessor;
+    runLast->next = successor;
+    if (predecessor == nullptr){
+        _head = runFirst;
+    } else {
+        predecessor->next = runFirst;
+    }
+    if (successor == nullptr){
+        _tail = runLast;
+    } else {
+        successor->previous = runLast;
+    }
+    _size += count;
+    _version++;
+    Churn(count);
+    return count;
+}
+/**
+ * Applies a batch of edits in one traversal. The surviving runs of nodes
+ * are kept and relinked, the removed nodes are freed and the inserted
+ * elements get new nodes between the runs. The end of a run is reached
+ * from the current node or from the tail, whichever is closer.
+ * @param batch the pieces of the list after the edits
+ * @param removed where the removed elements are written, in the order of
+ * their positions before the edits
+ * @return true, the list grows as needed
+ */
+bool DoubleLinkedList::ApplyBatch(const EditBatch& batch, Object** removed){
+    const vector<EditBatch::Piece>& pieces = batch.Pieces();
+    Node* node = _head;         // The node at position index of the original list
+    size_t index = 0;
+    Node* last = nullptr;       // The last node of the result so far
+    Node* newHead = nullptr;
+    for (const EditBatch::Piece& piece : pieces){
+        if (piece.element == nullptr){
+            for (; index < piece.first; index++){
+                Node* next = node->next;
+                *removed++ = node->data;
+                DeleteNode(node);
+                FilterRemoved();
+                node = next;
+            }
+            LIST_STATS_ADD(hops, index);
+            node->previous = last;
+            if (last == nullptr){
+                newHead = node;
+            } else {
+                last->next = node;
+            }
+            size_t end = piece.first + piece.count - 1;
+            if (_size - 1 - end < end - index){
+                last = _tail;
+                for (size_t i = _size - 1; i > end; i--){
+                    last = last->previous;
+                }
+                LIST_STATS_ADD(hops, _size - 1 - end);
+            } else {
+                last = node;
+                for (size_t i = index; i < end; i++){
+                    last = last->next;
+                }
+                LIST_STATS_ADD(hops, end - index);
+            }
+            node = last->next;
+            index = end + 1;
+        } else {
+            Node* neo = NewNode();
+            neo->data = piece.element;
+            neo->previous = last;
+            if (last == nullptr){
+                newHead = neo;
+            } else {
+                last->next = neo;
+            }
+            last = neo;
+            FilterAdd(piece.element);
+        }
+    }
+    for (; index < _size; index++){
+        Node* next = node->next;
+        *removed++ = node->data;
+        DeleteNode(node);
+        FilterRemoved();
+        node = next;
+    }
+    if (last != nullptr){
+        last->next = nullptr;
+    }
+    _head = newHead;
+    _tail = last;
+    _size = batch.Size();
+    _version++;
+    Churn(batch.Operations());
     return true;
 }
 
@@ -165,13 +316,20 @@ bool DoubleLinkedList::Insert(Object *element, size_t position) {
  * @return the position of the element if found, -1 otherwise.
  */
 int DoubleLinkedList::IndexOf(const Object *element) const {
+    LIST_STATS_SCOPE(INDEX_OF);
+    if (FilterExcludes(element)){
+        return -1;
+    }
     size_t index = 0;
     for (Node* tmp = _head; tmp != nullptr; tmp = tmp->next){
         if (tmp->data->Equals(*element)){
+            LIST_STATS_ADD(hops, index);
             return index;
         }
         index++;
     }
+    LIST_STATS_ADD(hops, index);
+    FilterMissed();
     return -1;
 }
 
@@ -188,6 +346,7 @@ int DoubleLinkedList::IndexOf(const Object *element) const {
  * nullptr otherwise
  */
 Object *DoubleLinkedList::Remove(size_t position) {
+    LIST_STATS_SCOPE(REMOVE);
 
     // If position is valid
     if (position >= _size) {
@@ -205,14 +364,18 @@ Object *DoubleLinkedList::Remove(size_t position) {
         if(_tail == _head){
             _tail = tmp;
         }
-        delete _head;
+        DeleteNode(_head);
         _head = tmp;
+        if (_head != nullptr){
+            _head->previous = nullptr;
+        }
     } else {
 
         tmp = _head; // Traverse list
         for (size_t i = 0; i < position -1; i++){
             tmp = tmp->next;
         }
+        LIST_STATS_ADD(hops, position - 1);
 
         Node* toRemove = tmp->next; // New node is going to be after current node
         retVal = toRemove->data;    // Holds value of new node
@@ -227,9 +390,12 @@ Object *DoubleLinkedList::Remove(size_t position) {
         }
         toRemove->previous = nullptr; // Clears original node
         toRemove->data = nullptr;     // Clears original node
-        delete toRemove;              // Deletes original node
+        DeleteNode(toRemove);         // Deletes original node
     }
     _size--;
+    _version++;
+    FilterRemoved();
+    Churn(1);
     return retVal;
 }
 
@@ -241,6 +407,7 @@ Object *DoubleLinkedList::Remove(size_t position) {
  * @return a pointer to the element if the position is valid, nullptr otherwise
  */
 Object *DoubleLinkedList::Get(size_t position) const {
+    LIST_STATS_SCOPE(GET);
     if (position >= _size){
         return nullptr;
     }
@@ -248,6 +415,7 @@ Object *DoubleLinkedList::Get(size_t position) const {
     for (size_t i = 0; i < position; i++) {
         tmp = tmp->next;
     }
+    LIST_STATS_ADD(hops, position);
     return tmp->data;
 }
 
@@ -274,18 +442,579 @@ string DoubleLinkedList::ToString() const {
  * Clear()
  * Very similar to the destructor, this method releases all the elements
  * of the list. It also sets the size to zero, and the head to nullptr.
- * This method makes the list become empty.
+ * This method makes the list become empty. With a reclaimer the nodes are
+ * detached in constant time and released later by the reclaimer.
  */
 void DoubleLinkedList::Clear() {
+    LIST_STATS_SCOPE(CLEAR);
+    FilterInvalidate();
+    if (Defer()){
+        return;
+    }
     Node* tempNode = _head;
     while (_head != nullptr){
         _head = tempNode->next;
         if (tempNode->data)
             delete tempNode->data;
-        delete tempNode;
+        DeleteNode(tempNode);
         tempNode = _head;
     }
+    ReleaseBlock();
     _head = nullptr;
     _tail = nullptr;
     _size = 0;
+    _version++;
+}
+
+/**
+ * Walk()
+ * Visits the nodes in order, one virtual call per element for the visitor
+ * instead of a Get per position
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool DoubleLinkedList::Walk(ElementVisitor &visitor) const {
+    return Visit([&visitor](Object* element){
+        return visitor.Visit(element);
+    });
+}
+
+/**
+ * Checks if the list keeps a filter up to date
+ * @return true, the filter follows the nodes that are linked and freed
+ */
+bool DoubleLinkedList::SupportsFilter() const {
+    return true;
+}
+
+/**
+ * MemoryUsage()
+ * Every element costs one node, the links are the overhead over the
+ * data pointer. The spare nodes of the block are the unused capacity.
+ * @return the bytes used by the list, its nodes and its elements
+ */
+ListMemoryUsage DoubleLinkedList::MemoryUsage() const {
+    ListMemoryUsage retVal;
+    retVal.container = sizeof(DoubleLinkedList) + FilterBytes();
+    retVal.storage = _size * sizeof(Node);
+    retVal.unused = _spareCount * sizeof(Node);
+    for (Node* tmp = _head; tmp != nullptr; tmp = tmp->next){
+        retVal.elements += tmp->data->FootprintBytes();
+    }
+    return retVal;
+}
+
+/**
+ * Splice()
+ * Moves count elements starting at first from other into this list at
+ * position. The run of nodes is unlinked from other and linked into this
+ * list as a whole, only the boundary nodes and the sizes change; the
+ * nodes and elements are not copied or reallocated. Finding the
+ * boundaries walks from the closest end of each list. Lists with
+ * different memory resources, or taking elements out of a defragmented
+ * list, move the elements one at a time instead.
+ * @param position where the first moved element will be in this list
+ * @param other the list the elements are taken from, must not be this list
+ * @param first the position of the first element to move in other
+ * @param count the number of elements to move
+ * @return true if the elements were moved, false if a range is invalid
+ */
+bool DoubleLinkedList::Splice(size_t position, DoubleLinkedList &other, size_t first, size_t count) {
+    if (&other == this || position > _size || first > other._size || count > other._size - first){
+        return false;
+    }
+    if (count == 0){
+        return true;
+    }
+    if (!_resource->IsEqual(*other._resource) || other._block != nullptr){
+        // Nodes cannot change resource or leave the block of other, move the elements one by one
+        for (size_t i = 0; i < count; i++){
+            Insert(other.Remove(first), position + i);
+        }
+        return true;
+    }
+
+    FilterInvalidate();
+    other.FilterInvalidate();
+
+    // Boundaries of the run in other
+    Node* runFirst = other.NodeAt(first);
+    Node* runLast = other.NodeAt(first + count - 1);
+    Node* before = runFirst->previous;
+    Node* after = runLast->next;
+
+    // Close the gap in other
+    if (before == nullptr){
+        other._head = after;
+    } else {
+        before->next = after;
+    }
+    if (after == nullptr){
+        other._tail = before;
+    } else {
+        after->previous = before;
+    }
+    other._size -= count;
+    other._version++;
+
+    // Open the gap in this list
+    Node* successor = position == _size ? nullptr : NodeAt(position);
+    Node* predecessor = successor == nullptr ? _tail : successor->previous;
+    runFirst->previous = predecessor;
+    runLast->next = successor;
+    if (predecessor == nullptr){
+        _head = runFirst;
+    } else {
+        predecessor->next = runFirst;
+    }
+    if (successor == nullptr){
+        _tail = runLast;
+    } else {
+        successor->previous = runLast;
+    }
+    _size += count;
+    _version++;
+    return true;
+}
+
+/**
+ * Concat()
+ * Moves every element of other to the end of this list in constant time,
+ * or linear time if the lists use different memory resources or other is
+ * defragmented. Other is left empty.
+ * @param other the list whose elements are appended, must not be this list
+ */
+void DoubleLinkedList::Concat(DoubleLinkedList &other) {
+    if (&other == this || other._head == nullptr){
+        return;
+    }
+    if (!_resource->IsEqual(*other._resource) || other._block != nullptr){
+        while (other._head != nullptr){
+            Insert(other.Remove(0), _size);
+        }
+        return;
+    }
+    if (_tail == nullptr){
+        _head = other._head;
+    } else {
+        _tail->next = other._head;
+        other._head->previous = _tail;
+    }
+    FilterInvalidate();
+    other.FilterInvalidate();
+    _tail = other._tail;
+    _size += other._size;
+    _version++;
+    other._head = nullptr;
+    other._tail = nullptr;
+    other._size = 0;
+    other._version++;
+}
+
+/**
+ * SplitAt()
+ * Moves the elements from position to the end into a new list, this list
+ * keeps the elements before position. Only the link between the two
+ * halves is cut, unless this list is defragmented: its nodes cannot leave
+ * the block, the moved elements get new nodes then.
+ * @param position the first element of the new list
+ * @return a newly allocated list that owns the moved elements, nullptr if
+ * the position is invalid
+ */
+DoubleLinkedList *DoubleLinkedList::SplitAt(size_t position) {
+    if (position > _size){
+        return nullptr;
+    }
+    DoubleLinkedList* retVal = new DoubleLinkedList(_resource);
+    if (position == _size){
+        return retVal;
+    }
+    FilterInvalidate();
+    Node* first = NodeAt(position);
+    if (_block != nullptr){
+        for (Node* tmp = first; tmp != nullptr; tmp = tmp->next){
+            retVal->Insert(tmp->data, retVal->_size);
+        }
+        _tail = first->previous;
+        while (first != nullptr){
+            Node* next = first->next;
+            DeleteNode(first);
+            first = next;
+        }
+        if (_tail == nullptr){
+            _head = nullptr;
+        } else {
+            _tail->next = nullptr;
+        }
+        _size = position;
+        _version++;
+        return retVal;
+    }
+    retVal->_head = first;
+    retVal->_tail = _tail;
+    retVal->_size = _size - position;
+
+    _tail = first->previous;
+    if (_tail == nullptr){
+        _head = nullptr;
+    } else {
+        _tail->next = nullptr;
+    }
+    first->previous = nullptr;
+    _size = position;
+    _version++;
+    return retVal;
+}
+
+/**
+ * DeepCopy()
+ * Creates a deep copy in the same resource. The nodes of the copy are
+ * allocated at once as a block, like Defragment does, so the threads do
+ * not allocate nodes. Each thread clones a range of elements and links the
+ * chain of nodes of its range, then the chains are stitched together.
+ * Resources other than the global heap are not synchronized, their copies
+ * are made in the calling thread.
+ * @param threads the threads to use, 0 for one per hardware thread
+ * @return a newly allocated list that owns the clones
+ */
+DoubleLinkedList *DoubleLinkedList::DeepCopy(size_t threads) const {
+    DoubleLinkedList* retVal = new DoubleLinkedList(_resource);
+    retVal->_defragmentThreshold = _defragmentThreshold;
+    if (_size == 0){
+        return retVal;
+    }
+    size_t ranges = _resource->IsEqual(*MemoryResource::Default()) ? ParallelRanges(_size, threads) : 1;
+    // The first node of every range, found in one walk
+    std::vector<Node*> starts(ranges);
+    Node* tmp = _head;
+    for (size_t range = 0, i = 0; range < ranges; range++){
+        for (size_t first = ParallelRangeStart(_size, ranges, range); i < first; i++){
+            tmp = tmp->next;
+        }
+        starts[range] = tmp;
+    }
+
+    Node* block = static_cast<Node*>(_resource->Allocate(_size * sizeof(Node), alignof(Node)));
+    MemoryResource* resource = _resource;
+    ParallelFor(_size, ranges, [&starts, block, resource](size_t range, size_t first, size_t last){
+        Node* source = starts[range];
+        for (size_t i = first; i < last; i++, source = source->next){
+            block[i].data = source->data->Clone(resource);
+            block[i].previous = i == first ? nullptr : block + i - 1;
+            block[i].next = i + 1 == last ? nullptr : block + i + 1;
+        }
+    });
+    for (size_t range = 1; range < ranges; range++){
+        size_t first = ParallelRangeStart(_size, ranges, range);
+        block[first - 1].next = block + first;
+        block[first].previous = block + first - 1;
+    }
+    retVal->_block = block;
+    retVal->_blockSize = _size;
+    retVal->_head = block;
+    retVal->_tail = block + _size - 1;
+    retVal->_size = _size;
+    return retVal;
+}
+
+/**
+ * NodeAt()
+ * Finds the node at a valid position, walking from the closest end of
+ * the list.
+ * @param position the position, must be less than the size
+ * @return the node at that position
+ */
+DoubleLinkedList::Node *DoubleLinkedList::NodeAt(size_t position) const {
+    Node* tmp = nullptr;
+    if (position < _size / 2){
+        tmp = _head;
+        for (size_t i = 0; i < position; i++){
+            tmp = tmp->next;
+        }
+        LIST_STATS_ADD(hops, position);
+    } else {
+        tmp = _tail;
+        for (size_t i = _size - 1; i > position; i--){
+            tmp = tmp->previous;
+        }
+        LIST_STATS_ADD(hops, _size - 1 - position);
+    }
+    return tmp;
+}
+
+/**
+ * The node chain of a list handed to a reclaimer, released from the head a
+ * budget at a time.
+ */
+class DoubleLinkedList::Garbage : public Reclaimer::Garbage{
+    Node* _head;
+    MemoryResource* _resource;
+    Node* _block;       // Released as a whole after the chain
+    size_t _blockSize;
+public:
+    Garbage(Node* head, MemoryResource* resource, Node* block, size_t blockSize) : _head(head),
+        _resource(resource), _block(block), _blockSize(blockSize){}
+    virtual ~Garbage(){
+        while (!Done()){
+            Release(Reclaimer::BATCH);
+        }
+    }
+    virtual size_t Release(size_t budget){
+        size_t retVal = 0;
+        while (_head != nullptr && retVal < budget){
+            Node* tempNode = _head;
+            _head = tempNode->next;
+            delete tempNode->data;
+            if (_block == nullptr || tempNode < _block || tempNode >= _block + _blockSize){
+                _resource->Deallocate(tempNode, sizeof(Node), alignof(Node));
+            }
+            retVal++;
+        }
+        if (_head == nullptr && _block != nullptr){
+            _resource->Deallocate(_block, _blockSize * sizeof(Node), alignof(Node));
+            _block = nullptr;
+        }
+        return retVal;
+    }
+    virtual bool Done()const{
+        return _head == nullptr && _block == nullptr;
+    }
+};
+
+/**
+ * Detaches the node chain and hands it to the reclaimer, the list is left
+ * empty. Nothing is deferred for an empty list.
+ * @return true if there is a reclaimer and the list is now empty
+ */
+bool DoubleLinkedList::Defer(){
+    if (_reclaimer == nullptr){
+        return false;
+    }
+    if (_head != nullptr){
+        _reclaimer->Defer(new Garbage(_head, _resource, _block, _blockSize));
+    } else if (_block != nullptr){
+        _resource->Deallocate(_block, _blockSize * sizeof(Node), alignof(Node));
+    }
+    _block = nullptr;
+    _blockSize = 0;
+    _spare = nullptr;
+    _spareCount = 0;
+    _head = nullptr;
+    _tail = nullptr;
+    _size = 0;
+    _version++;
+    return true;
+}
+
+/**
+ * FillFilter()
+ * Adds every element to the filter without going through Get
+ */
+void DoubleLinkedList::FillFilter() const {
+    for (Node* tmp = _head; tmp != nullptr; tmp = tmp->next){
+        _filter->Add(tmp->data->Hash());
+    }
+}
+
+/**
+ * NewNode()
+ * Allocates an uninitialized node, a spare node of the block if there is
+ * one, otherwise from the resource of the list
+ * @return the node
+ */
+DoubleLinkedList::Node *DoubleLinkedList::NewNode() {
+    if (_spare != nullptr){
+        Node* retVal = _spare;
+        _spare = retVal->next;
+        _spareCount--;
+        return retVal;
+    }
+    return static_cast<Node*>(_resource->Allocate(sizeof(Node), alignof(Node)));
+}
+
+/**
+ * DeleteNode()
+ * Gives a node allocated by NewNode back to the resource of the list,
+ * nodes of the block become spare nodes
+ * @param node the node, its element is not deleted
+ */
+void DoubleLinkedList::DeleteNode(Node *node) {
+    if (InBlock(node)){
+        node->next = _spare;
+        _spare = node;
+        _spareCount++;
+        return;
+    }
+    _resource->Deallocate(node, sizeof(Node), alignof(Node));
+}
+
+/**
+ * MoveToFront()
+ * Relinks a node of the list as the head without walking the list
+ * @param node a node of this list
+ */
+void DoubleLinkedList::MoveToFront(Node *node) {
+    if (node == _head){
+        return;
+    }
+    node->previous->next = node->next;
+    if (node->next != nullptr){
+        node->next->previous = node->previous;
+    } else {
+        _tail = node->previous;
+    }
+    node->previous = nullptr;
+    node->next = _head;
+    _head->previous = node;
+    _head = node;
+    _version++;
+}
+
+/**
+ * Unlink()
+ * Removes a node of the list without walking the list, Remove for a node
+ * that is already known
+ * @param node a node of this list, it is deleted
+ * @return the element of the node, the caller owns it
+ */
+Object *DoubleLinkedList::Unlink(Node *node) {
+    Object* retVal = node->data;
+    if (node->previous != nullptr){
+        node->previous->next = node->next;
+    } else {
+        _head = node->next;
+    }
+    if (node->next != nullptr){
+        node->next->previous = node->previous;
+    } else {
+        _tail = node->previous;
+    }
+    DeleteNode(node);
+    _size--;
+    _version++;
+    FilterRemoved();
+    Churn(1);
+    return retVal;
+}
+
+/**
+ * GetResource()
+ * @return where the nodes of the list are allocated
+ */
+MemoryResource *DoubleLinkedList::GetResource() const {
+    return _resource;
+}
+
+/**
+ * InBlock()
+ * @param node a node of the list
+ * @return true if the node is part of the block made by Defragment
+ */
+bool DoubleLinkedList::InBlock(const Node *node) const {
+    return _block != nullptr && node >= _block && node < _block + _blockSize;
+}
+
+/**
+ * ReleaseBlock()
+ * Gives the block back to the resource, every node of it must be spare
+ */
+void DoubleLinkedList::ReleaseBlock() {
+    if (_block != nullptr){
+        _resource->Deallocate(_block, _blockSize * sizeof(Node), alignof(Node));
+    }
+    _block = nullptr;
+    _blockSize = 0;
+    _spare = nullptr;
+    _spareCount = 0;
+}
+
+/**
+ * Churn()
+ * Counts allocated and freed nodes. With a threshold, once the churn
+ * reaches the size of the list (and at least DEFRAGMENT_INTERVAL) the
+ * locality is measured and the list is defragmented if it is below the
+ * threshold, so the checks cost constant amortized time per node.
+ * @param nodes the nodes allocated or freed by an operation
+ */
+void DoubleLinkedList::Churn(size_t nodes) {
+    if (_defragmentThreshold <= 0){
+        return;
+    }
+    _churn += nodes;
+    if (_churn >= _size && _churn >= DEFRAGMENT_INTERVAL){
+        _churn = 0;
+        if (Locality() < _defragmentThreshold){
+            Defragment();
+        }
+    }
+}
+
+/**
+ * Locality()
+ * How well the order of the nodes in memory follows the order of the
+ * list: the fraction of links that point forward to a node at most
+ * LOCALITY_DISTANCE bytes away, where the hardware prefetcher or the same
+ * cache line already has it.
+ * @return a value in [0, 1], 1 for lists of fewer than two elements
+ */
+double DoubleLinkedList::Locality() const {
+    if (_size < 2){
+        return 1;
+    }
+    size_t local = 0;
+    for (Node* tmp = _head; tmp->next != nullptr; tmp = tmp->next){
+        uintptr_t from = reinterpret_cast<uintptr_t>(tmp);
+        uintptr_t to = reinterpret_cast<uintptr_t>(tmp->next);
+        local += to > from && to - from <= LOCALITY_DISTANCE;
+    }
+    return static_cast<double>(local) / (_size - 1);
+}
+
+/**
+ * Defragment()
+ * Moves every node into one block allocated from the resource of the
+ * list, laid out in list order, and relinks them. The elements are not
+ * touched, only the nodes move, so views of the list become invalid. The
+ * old nodes are freed and a previous block is given back whole. Nodes
+ * removed later stay in the block as spare nodes for the next inserts.
+ */
+void DoubleLinkedList::Defragment() {
+    Node* block = _size == 0 ? nullptr : static_cast<Node*>(_resource->Allocate(_size * sizeof(Node), alignof(Node)));
+    Node* tmp = _head;
+    for (size_t i = 0; i < _size; i++){
+        Node* next = tmp->next;
+        block[i].data = tmp->data;
+        block[i].previous = i == 0 ? nullptr : block + i - 1;
+        block[i].next = i + 1 == _size ? nullptr : block + i + 1;
+        if (!InBlock(tmp)){
+            _resource->Deallocate(tmp, sizeof(Node), alignof(Node));
+        }
+        tmp = next;
+    }
+    ReleaseBlock();
+    _block = block;
+    _blockSize = _size;
+    _head = block;
+    _tail = block == nullptr ? nullptr : block + _size - 1;
+    _churn = 0;
+    _version++;
+}
+
+/**
+ * SetDefragmentThreshold()
+ * Makes the list defragment itself when its locality drops below a
+ * threshold, checked as nodes are allocated and freed
+ * @param locality the threshold in [0, 1], 0 turns it off
+ */
+void DoubleLinkedList::SetDefragmentThreshold(double locality) {
+    _defragmentThreshold = locality;
+    _churn = 0;
+}
+
+/**
+ * GetDefragmentThreshold()
+ * @return the locality below which the list defragments itself, 0 if never
+ */
+double DoubleLinkedList::GetDefragmentThreshold() const {
+    return _defragmentThreshold;
 }
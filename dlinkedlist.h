@@ -12,7 +12,7 @@ using std::string;
 #define ADT_LIST_FULL_DLINKEDLIST_H
 
 
-class DoubleLinkedList : public List {
+class DoubleLinkedList final : public List {
 	struct Node{
 		Object* data;
 		Node* next;
@@ -20,10 +20,34 @@ class DoubleLinkedList : public List {
 	};
 	Node* _head;
 	Node* _tail;
+	MemoryResource* _resource;
+	Node* _block;			// Nodes laid out in list order by Defragment, nullptr if none
+	size_t _blockSize;
+	Node* _spare;			// Free nodes of the block, reused by NewNode
+	size_t _spareCount;
+	double _defragmentThreshold;	// Locality below which the list defragments itself, 0 never
+	size_t _churn;			// Nodes allocated and freed since the locality was last checked
+	class Garbage;
+	template <class> friend class SubList;
+	friend class LruCache;
 	DoubleLinkedList(const DoubleLinkedList& other);
 	DoubleLinkedList& operator=(const DoubleLinkedList& rhs);
+	Node* NodeAt(size_t position)const;
+	bool Defer();
+	virtual void FillFilter()const;
+	virtual bool ApplyBatch(const EditBatch& batch, Object** removed);
+	Node* NewNode();
+	void DeleteNode(Node* node);
+	bool InBlock(const Node* node)const;
+	void ReleaseBlock();
+	void Churn(size_t nodes);
+	void MoveToFront(Node* node);
+	Object* Unlink(Node* node);
 public:
-	DoubleLinkedList();
+	static const size_t LOCALITY_DISTANCE = 64;		// Bytes, a link this far ahead is local
+	static const size_t DEFRAGMENT_INTERVAL = 1024;	// Minimum churn between locality checks
+
+	DoubleLinkedList(MemoryResource* resource = MemoryResource::Default());
 	virtual ~DoubleLinkedList();
 	virtual bool Insert(Object* element, size_t position);
 	virtual int IndexOf(const Object* element)const;
@@ -31,8 +55,41 @@ public:
 	virtual Object* Get(size_t position)const;
 	virtual string ToString()const;
 	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+	virtual size_t InsertRange(Object* const* elements, size_t count, size_t position);
+
+	bool Splice(size_t position, DoubleLinkedList& other, size_t first, size_t count);
+	void Concat(DoubleLinkedList& other);
+	DoubleLinkedList* SplitAt(size_t position);
+	DoubleLinkedList* DeepCopy(size_t threads = 0)const;
+	MemoryResource* GetResource()const;
+	double Locality()const;
+	void Defragment();
+	void SetDefragmentThreshold(double locality);
+	double GetDefragmentThreshold()const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
 
 };
 
+/**
+ * Visits the elements in order without virtual dispatch, the loop can be
+ * inlined into the caller. Used by the algorithms in algorithms.h.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool DoubleLinkedList::Visit(Visitor visitor)const{
+	for (Node* tmp = _head; tmp != nullptr; tmp = tmp->next){
+		if (!visitor(tmp->data)){
+			return false;
+		}
+	}
+	return true;
+}
+
 
 #endif //ADT_LIST_FULL_DLINKEDLIST_H
@@ -0,0 +1,192 @@
+/*
+ * Title:		Edit Batch
+ * Purpose:		Implementation of the batch of positional edits. Recording an
+ * 				operation walks the pieces, not the list, so it costs the
+ * 				number of operations recorded so far.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "editbatch.h"
+#include "list.h"
+
+#include <algorithm>
+
+/**
+ * Constructor
+ * The positions of the operations start from the current state of the list
+ * @param list the list the batch will be applied to
+ */
+EditBatch::EditBatch(const List& list) : _list(&list), _size(list.Size()), _originalSize(list.Size()),
+	_version(list.GetVersion()), _removedOriginals(0), _applied(false){
+	_pieces.reserve(RESERVED);
+	_removals.reserve(RESERVED);
+	if (_size > 0){
+		_pieces.push_back({nullptr, 0, _size});
+	}
+}
+/**
+ * Finds the piece that holds a position
+ * @param position the position in the list after the operations recorded so
+ * far, replaced by the offset inside the piece
+ * @return the index of the piece, the number of pieces for the end of the list
+ */
+size_t EditBatch::Find(size_t& position)const{
+	size_t piece = 0;
+	while (piece < _pieces.size() && position >= _pieces[piece].count){
+		position -= _pieces[piece].count;
+		piece++;
+	}
+	return piece;
+}
+/**
+ * Records an insert, the list does not change until Apply
+ * @param element the element to insert, owned by the list once the batch
+ * is applied, deleted if the list refuses it
+ * @param position where the element goes after the operations before it
+ * @return false if the position is invalid, the element is nullptr or the
+ * batch was applied
+ */
+bool EditBatch::Insert(Object* element, size_t position){
+	if (_applied || element == nullptr || position > _size){
+		return false;
+	}
+	size_t offset = position;
+	size_t piece = Find(offset);
+	if (offset > 0){
+		// In the middle of a run, split it
+		Piece& run = _pieces[piece];
+		Piece tail = {nullptr, run.first + offset, run.count - offset};
+		run.count = offset;
+		_pieces.insert(_pieces.begin() + piece + 1, tail);
+		piece++;
+	}
+	Piece inserted = {element, 0, 1};
+	_pieces.insert(_pieces.begin() + piece, inserted);
+	_size++;
+	return true;
+}
+/**
+ * Records a remove, the list does not change until Apply
+ * @param position the element to remove after the operations before it
+ * @return false if the position is invalid or the batch was applied
+ */
+bool EditBatch::Remove(size_t position){
+	if (_applied || position >= _size){
+		return false;
+	}
+	size_t offset = position;
+	size_t piece = Find(offset);
+	Piece& run = _pieces[piece];
+	if (run.element != nullptr){
+		_removals.push_back({run.element, 0});
+		_pieces.erase(_pieces.begin() + piece);
+	}else{
+		_removals.push_back({nullptr, run.first + offset});
+		_removedOriginals++;
+		if (run.count == 1){
+			_pieces.erase(_pieces.begin() + piece);
+		}else if (offset == 0){
+			run.first++;
+			run.count--;
+		}else if (offset == run.count - 1){
+			run.count--;
+		}else{
+			Piece tail = {nullptr, run.first + offset + 1, run.count - offset - 1};
+			run.count = offset;
+			_pieces.insert(_pieces.begin() + piece + 1, tail);
+		}
+	}
+	_size--;
+	return true;
+}
+/**
+ * Applies every operation to the list. The list must be the one the batch
+ * was created for and must not have changed since (VSArray and
+ * DoubleLinkedList are checked with their version, other lists only with
+ * their size).
+ * @param list the list the batch was created for
+ * @return false if the list is not in the state the batch was recorded
+ * against or the batch was already applied, nothing is changed then. Also
+ * false if the list refused an inserted element (a StaticArrayList that is
+ * full, a SharedList out of records): the list keeps its elements, the
+ * elements the batch inserts are deleted and the batch is left empty.
+ */
+bool EditBatch::Apply(List& list){
+	if (_applied || &list != _list || list.Size() != _originalSize || list.GetVersion() != _version){
+		return false;
+	}
+	// The list reports the elements it removes in the order of their positions
+	vector<Object*> removed(_removedOriginals);
+	if (Operations() > 0 && !list.ApplyBatch(*this, removed.data())){
+		for (const Removal& removal : _removals){
+			delete removal.element;
+		}
+		_removals.clear();
+		_removedOriginals = 0;
+		_pieces.clear();
+		_size = _originalSize = list.Size();
+		_version = list.GetVersion();
+		if (_size > 0){
+			_pieces.push_back({nullptr, 0, _size});
+		}
+		return false;
+	}
+	vector<size_t> positions;
+	for (const Removal& removal : _removals){
+		if (removal.element == nullptr){
+			positions.push_back(removal.original);
+		}
+	}
+	std::sort(positions.begin(), positions.end());
+	for (Removal& removal : _removals){
+		if (removal.element == nullptr){
+			removal.element = removed[std::lower_bound(positions.begin(), positions.end(), removal.original) - positions.begin()];
+		}
+	}
+	_applied = true;
+	return true;
+}
+/**
+ * Size accessor
+ * @return the size of the list after the batch
+ */
+size_t EditBatch::Size()const{
+	return _size;
+}
+/**
+ * Operation count accessor
+ * @return the number of inserts and removes recorded
+ */
+size_t EditBatch::Operations()const{
+	return _removals.size() + (_size + _removals.size() - _originalSize);
+}
+bool EditBatch::IsApplied()const{
+	return _applied;
+}
+/**
+ * Removed elements, the caller owns them once the batch is applied, the
+ * same as the elements returned by List::Remove
+ * @return the removed elements in the order of the Remove calls, elements
+ * of the list are nullptr until the batch is applied
+ */
+vector<Object*> EditBatch::Removed()const{
+	vector<Object*> retVal;
+	for (const Removal& removal : _removals){
+		retVal.push_back(removal.element);
+	}
+	return retVal;
+}
+/**
+ * Pieces accessor, used by the lists to apply the batch
+ * @return the pieces of the list after the batch, in order
+ */
+const vector<EditBatch::Piece>& EditBatch::Pieces()const{
+	return _pieces;
+}
+/**
+ * Original size accessor
+ * @return the size of the list when the batch was created
+ */
+size_t EditBatch::OriginalSize()const{
+	return _originalSize;
+}
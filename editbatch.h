@@ -0,0 +1,72 @@
+/*
+ * Title:		Edit Batch
+ * Purpose:		Declaration of a batch of positional inserts and removes that
+ * 				is applied to a list in one pass. Each operation is recorded
+ * 				with the position it would have if the operations before it
+ * 				had already been applied, as in a sequence of Insert and
+ * 				Remove calls. The batch keeps the resulting order of the list
+ * 				as pieces: runs of the elements the list held when the batch
+ * 				was created and elements inserted by the batch.
+ *
+ * 				VSArray moves each surviving run once, DoubleLinkedList links
+ * 				the result in one traversal. Other lists remove and insert
+ * 				one element at a time, the result is the same.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef EDIT_BATCH_H
+#define EDIT_BATCH_H
+
+#include "object.h"
+
+#include <cstddef>
+#include <vector>
+using std::vector;
+
+class List;
+
+class EditBatch{
+public:
+	/**
+	 * A piece of the list after the batch: when element is nullptr, the
+	 * elements that were in positions [first, first + count) when the batch
+	 * was created, otherwise an element inserted by the batch (count is 1)
+	 */
+	struct Piece{
+		Object* element;
+		size_t first;
+		size_t count;
+	};
+private:
+	static const size_t RESERVED = 32;	// Pieces and removals reserved up front
+	struct Removal{
+		Object* element;	// nullptr until the batch is applied for elements of the list
+		size_t original;	// Position in the list when the batch was created
+	};
+	const List* _list;
+	size_t _size;					// Size of the list after the batch
+	size_t _originalSize;
+	unsigned long long _version;
+	vector<Piece> _pieces;
+	vector<Removal> _removals;
+	size_t _removedOriginals;		// Removals of elements the list held
+	bool _applied;
+	size_t Find(size_t& position)const;
+	EditBatch(const EditBatch&);
+	const EditBatch& operator=(const EditBatch&);
+public:
+	explicit EditBatch(const List& list);
+
+	bool Insert(Object* element, size_t position);
+	bool Remove(size_t position);
+	bool Apply(List& list);
+
+	size_t Size()const;
+	size_t Operations()const;
+	bool IsApplied()const;
+	vector<Object*> Removed()const;
+	const vector<Piece>& Pieces()const;
+	size_t OriginalSize()const;
+};
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ * Title:		Gap Buffer List
+ * Purpose:		Implementation of the gap buffer list. The slots in
+ * 				[_gapStart, _gapEnd) are free, position p is in slot p before
+ * 				the gap and in slot p + gap length after it. The gap stays
+ * 				where the last edit left it.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "gapbufferlist.h"
+
+#include <algorithm>
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+/**
+ * Constructor with capacity
+ * The whole array starts as the gap, at position 0
+ * @param capacity the number of elements the list holds before growing
+ * @param increasePercentage the growth of the array when the gap is closed
+ */
+GapBufferList::GapBufferList(size_t capacity, double increasePercentage) :
+		_data(nullptr), _capacity(capacity), _delta(increasePercentage), _gapStart(0), _gapEnd(capacity){
+	_data = new Object*[_capacity];
+}
+/**
+ * Destructor
+ * Releases every element and then the array
+ */
+GapBufferList::~GapBufferList(){
+	Visit([](Object* element){
+		delete element;
+		return true;
+	});
+	delete[] _data;
+}
+/**
+ * Inserts an element into a given position.
+ * Moves the gap to the position, growing the array if the gap is closed,
+ * and puts the element in the first slot of the gap.
+ * @param element what the client wants to insert into the list
+ * @param position the position where the element is to be inserted
+ * @return true if it was possible to insert, false if the position is invalid
+ */
+bool GapBufferList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size){
+		return false;
+	}
+	if (_gapStart == _gapEnd){
+		Resize();
+	}
+	MoveGap(position);
+	_data[_gapStart++] = element;
+	_size++;
+	_version++;
+	FilterAdd(element);
+	return true;
+}
+/**
+ * Searches for the position of an element in the list.
+ * Linear search of the elements before the gap and then after it. With a
+ * filter, elements certainly absent are not searched.
+ * @param element the object that the client is searching for.
+ * @return the position of the element if found, -1 otherwise.
+ */
+int GapBufferList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (FilterExcludes(element)){
+		return -1;
+	}
+	for (size_t i = 0; i < _gapStart; i++){
+		if (_data[i]->Equals(*element)){
+			return static_cast<int>(i);
+		}
+	}
+	for (size_t i = _gapEnd; i < _capacity; i++){
+		if (_data[i]->Equals(*element)){
+			return static_cast<int>(i - (_gapEnd - _gapStart));
+		}
+	}
+	FilterMissed();
+	return -1;
+}
+/**
+ * Removes the element at position, when the position is valid. The gap is
+ * moved to the position and widened over the element, which is left to the
+ * client.
+ * @param position the position of the element to be removed.
+ * @return the pointer to the object in that position if the position was valid,
+ * nullptr otherwise
+ */
+Object* GapBufferList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	MoveGap(position);
+	Object* retVal = _data[_gapEnd++];
+	_size--;
+	_version++;
+	FilterRemoved();
+	return retVal;
+}
+/**
+ * Element Access
+ * Does not move the gap.
+ * @param position the position of the element to retrieve.
+ * @return a pointer to the element if the position is valid, nullptr otherwise
+ */
+Object* GapBufferList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	return position < _size ? _data[Slot(position)] : nullptr;
+}
+/**
+ * Creates a string representation of the list, surrounding the elements
+ * with curly braces and separating them by comma. Example: {2, 6, 8}
+ * @return a string representation of the list
+ */
+string GapBufferList::ToString()const{
+	stringstream retVal;
+	retVal << "{";
+	bool first = true;
+	Visit([&retVal, &first](Object* element){
+		retVal << (first ? "" : ", ") << element->ToString();
+		first = false;
+		return true;
+	});
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Releases all the elements of the list. The array is kept and becomes
+ * the gap again, at position 0.
+ */
+void GapBufferList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	FilterInvalidate();
+	Visit([](Object* element){
+		delete element;
+		return true;
+	});
+	_gapStart = 0;
+	_gapEnd = _capacity;
+	_size = 0;
+	_version++;
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool GapBufferList::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Checks if the list keeps a filter up to date
+ * @return true, filling and widening the gap update the filter
+ */
+bool GapBufferList::SupportsFilter()const{
+	return true;
+}
+/**
+ * Memory usage breakdown
+ * The slots holding elements are storage, the gap is unused capacity
+ * @return the bytes used by the list, its array and its elements
+ */
+ListMemoryUsage GapBufferList::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(GapBufferList) + FilterBytes();
+	retVal.storage = _size * sizeof(Object*);
+	retVal.unused = (_gapEnd - _gapStart) * sizeof(Object*);
+	Visit([&retVal](Object* element){
+		retVal.elements += element->FootprintBytes();
+		return true;
+	});
+	return retVal;
+}
+/**
+ * Capacity accessor
+ * @return the number of slots in the array, elements and gap
+ */
+size_t GapBufferList::GetCapacity()const{
+	return _capacity;
+}
+/**
+ * Gap accessor
+ * @return the position the next insert costs nothing at, where the last
+ * edit happened
+ */
+size_t GapBufferList::GetGapPosition()const{
+	return _gapStart;
+}
+/**
+ * Adds every element to the filter without going through Get
+ */
+void GapBufferList::FillFilter()const{
+	Visit([this](Object* element){
+		_filter->Add(element->Hash());
+		return true;
+	});
+}
+/**
+ * Grows the array by a fraction _delta of its capacity, same policy as
+ * VSArray. The elements before the gap stay at the start, the elements
+ * after it move to the end of the new array, the gap takes the new slots.
+ */
+void GapBufferList::Resize(){
+	size_t higherCapacity = static_cast<size_t>(_capacity * (_delta + 1));
+	if (higherCapacity <= _capacity){
+		higherCapacity = _capacity + 1; // Small capacities would not grow otherwise
+	}
+	LIST_STATS_ADD(resizes, 1);
+	LIST_STATS_ADD(bytesMoved, _size * sizeof(Object*));
+	Object** tempData = new Object*[higherCapacity];
+	size_t after = _capacity - _gapEnd;
+	std::copy(_data, _data + _gapStart, tempData);
+	std::copy(_data + _gapEnd, _data + _capacity, tempData + higherCapacity - after);
+	delete[] _data;
+	_data = tempData;
+	_capacity = higherCapacity;
+	_gapEnd = _capacity - after;
+}
+/**
+ * Moves the gap so it starts at a position, copying the elements between
+ * the current position of the gap and the new one across it
+ * @param position the new position of the gap, at most the size
+ */
+void GapBufferList::MoveGap(size_t position){
+	if (position < _gapStart){
+		size_t count = _gapStart - position;
+		LIST_STATS_ADD(shifts, count);
+		std::copy_backward(_data + position, _data + _gapStart, _data + _gapEnd);
+		_gapStart -= count;
+		_gapEnd -= count;
+	}else if (position > _gapStart){
+		size_t count = position - _gapStart;
+		LIST_STATS_ADD(shifts, count);
+		std::copy(_data + _gapEnd, _data + _gapEnd + count, _data + _gapStart);
+		_gapStart += count;
+		_gapEnd += count;
+	}
+}
+/**
+ * Slot of a valid position
+ * @param position the position, must be less than the size
+ * @return the index in the array of the element at that position
+ */
+size_t GapBufferList::Slot(size_t position)const{
+	return position < _gapStart ? position : position + (_gapEnd - _gapStart);
+}
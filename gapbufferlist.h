@@ -0,0 +1,78 @@
+/*
+ * Title:		Gap Buffer List
+ * Purpose:		Declaration of a list stored in one array with a gap of free
+ * 				slots, as text editors store the text around the cursor. The
+ * 				elements before the gap are at the start of the array and the
+ * 				elements after it at the end. Insert and Remove first move the
+ * 				gap to the position, copying only the elements between the
+ * 				old and the new position, then fill or widen the gap in place.
+ * 				Edits near the previous one are O(1) amortized, Get is O(1).
+ * 				The array grows by the same _delta policy as VSArray.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef GAP_BUFFER_LIST_H
+#define GAP_BUFFER_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <string>
+using std::string;
+
+class GapBufferList final : public List{
+	Object** _data;
+	size_t _capacity;
+	double _delta;
+	size_t _gapStart;	// First free slot, also the position of the gap
+	size_t _gapEnd;		// Slot of the first element after the gap
+	GapBufferList(const GapBufferList&);
+	const GapBufferList& operator=(const GapBufferList&);
+	virtual void FillFilter()const;
+	void Resize();
+	void MoveGap(size_t position);
+	size_t Slot(size_t position)const;
+public:
+	GapBufferList(size_t capacity = 16, double increasePercentage = 0.5);
+	virtual ~GapBufferList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+
+	size_t GetCapacity()const;
+	size_t GetGapPosition()const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+/**
+ * Visits the elements in order without virtual dispatch, the elements
+ * before the gap and then the ones after it. Used by the algorithms in
+ * algorithms.h.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool GapBufferList::Visit(Visitor visitor)const{
+	for (size_t i = 0; i < _gapStart; i++){
+		if (!visitor(_data[i])){
+			return false;
+		}
+	}
+	for (size_t i = _gapEnd; i < _capacity; i++){
+		if (!visitor(_data[i])){
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
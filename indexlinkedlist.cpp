@@ -0,0 +1,282 @@
+/*
+ * Title:		Index Linked List
+ * Purpose:		Implementation of a doubly linked list stored in a contiguous
+ * 				array of nodes. A node is a data pointer and two 32 bit links,
+ * 				16 bytes instead of the 24 of a DoubleLinkedList node plus its
+ * 				allocation. Compact() renumbers the nodes in list order so a
+ * 				traversal reads the array sequentially.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "indexlinkedlist.h"
+
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+/**
+ * Constructor with capacity
+ * Allocates the node array and puts every node in the free list
+ * @param capacity the number of nodes allocated up front
+ * @param increasePercentage the growth of the node array when it is full
+ */
+IndexLinkedList::IndexLinkedList(size_t capacity, double increasePercentage) :
+		_nodes(nullptr), _capacity(capacity), _delta(increasePercentage), _head(NIL), _tail(NIL), _free(NIL){
+	_nodes = new Node[_capacity];
+	LinkFree(0);
+}
+/**
+ * Destructor
+ * Releases every element and then the node array
+ */
+IndexLinkedList::~IndexLinkedList(){
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		delete _nodes[tmp].data;
+	}
+	delete[] _nodes;
+}
+/**
+ * Inserts an element into a given position.
+ * Takes a node from the free list, growing the array if there is none,
+ * and links it walking from the closest end of the list.
+ * @param element what the client wants to insert into the list
+ * @param position the position where the element is to be inserted
+ * @return true if it was possible to insert, false if the position is invalid
+ * or the list already holds the maximum number of nodes an index can address
+ */
+bool IndexLinkedList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size || _size == NIL){
+		return false;
+	}
+	if (_free == NIL){
+		Resize();
+	}
+	uint32_t neo = _free;
+	_free = _nodes[neo].next;
+
+	uint32_t successor = position == _size ? NIL : At(position);
+	uint32_t predecessor = successor == NIL ? _tail : _nodes[successor].previous;
+	_nodes[neo].data = element;
+	_nodes[neo].next = successor;
+	_nodes[neo].previous = predecessor;
+	if (predecessor == NIL){
+		_head = neo;
+	}else{
+		_nodes[predecessor].next = neo;
+	}
+	if (successor == NIL){
+		_tail = neo;
+	}else{
+		_nodes[successor].previous = neo;
+	}
+	_size++;
+	return true;
+}
+/**
+ * Searches for the position of an element in the list.
+ * The method performs a linear search, following the links.
+ * @param element the object that the client is searching for.
+ * @return the position of the element if found, -1 otherwise.
+ */
+int IndexLinkedList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	int index = 0;
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		if (_nodes[tmp].data->Equals(*element)){
+			LIST_STATS_ADD(hops, index);
+			return index;
+		}
+		index++;
+	}
+	LIST_STATS_ADD(hops, index);
+	return -1;
+}
+/**
+ * Removes the element at position, when the position is valid. The node
+ * goes back to the free list, the element is left to the client.
+ * @param position the position of the element to be removed.
+ * @return the pointer to the object in that position if the position was valid,
+ * nullptr otherwise
+ */
+Object* IndexLinkedList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	uint32_t node = At(position);
+	Node& removed = _nodes[node];
+	Object* retVal = removed.data;
+	if (removed.previous == NIL){
+		_head = removed.next;
+	}else{
+		_nodes[removed.previous].next = removed.next;
+	}
+	if (removed.next == NIL){
+		_tail = removed.previous;
+	}else{
+		_nodes[removed.next].previous = removed.previous;
+	}
+	removed.data = nullptr;
+	removed.previous = NIL;
+	removed.next = _free;
+	_free = node;
+	_size--;
+	return retVal;
+}
+/**
+ * Element Access
+ * Walks from the closest end of the list to the position.
+ * @param position the position of the element to retrieve.
+ * @return a pointer to the element if the position is valid, nullptr otherwise
+ */
+Object* IndexLinkedList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	if (position >= _size){
+		return nullptr;
+	}
+	return _nodes[At(position)].data;
+}
+/**
+ * Creates a string representation of the list, surrounding the elements
+ * with curly braces and separating them by comma. Example: {2, 6, 8}
+ * @return a string representation of the list
+ */
+string IndexLinkedList::ToString()const{
+	stringstream retVal;
+	retVal << "{";
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		retVal << _nodes[tmp].data->ToString() << (_nodes[tmp].next == NIL ? "" : ", ");
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Releases all the elements of the list. The node array is kept and all
+ * its nodes go back to the free list, in array order.
+ */
+void IndexLinkedList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		delete _nodes[tmp].data;
+	}
+	_head = NIL;
+	_tail = NIL;
+	_free = NIL;
+	_size = 0;
+	LinkFree(0);
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool IndexLinkedList::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Memory usage breakdown
+ * Nodes in use are storage, free nodes are unused capacity
+ * @return the bytes used by the list, its node array and its elements
+ */
+ListMemoryUsage IndexLinkedList::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(IndexLinkedList);
+	retVal.storage = _size * sizeof(Node);
+	retVal.unused = (_capacity - _size) * sizeof(Node);
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		retVal.elements += _nodes[tmp].data->FootprintBytes();
+	}
+	return retVal;
+}
+/**
+ * Renumbers the nodes so the list occupies the first _size slots of the
+ * array in list order, then a traversal reads the array sequentially.
+ * The free nodes are relinked after them. Elements are not touched.
+ */
+void IndexLinkedList::Compact(){
+	Node* compacted = new Node[_capacity];
+	uint32_t index = 0;
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		compacted[index].data = _nodes[tmp].data;
+		compacted[index].previous = index == 0 ? NIL : index - 1;
+		compacted[index].next = index + 1 == _size ? NIL : index + 1;
+		index++;
+	}
+	delete[] _nodes;
+	_nodes = compacted;
+	_head = _size == 0 ? NIL : 0;
+	_tail = _size == 0 ? NIL : static_cast<uint32_t>(_size - 1);
+	_free = NIL;
+	LinkFree(_size);
+}
+/**
+ * Capacity accessor
+ * @return the number of nodes in the array, used or free
+ */
+size_t IndexLinkedList::GetCapacity()const{
+	return _capacity;
+}
+/**
+ * Grows the node array by a fraction _delta of its capacity, same policy
+ * as VSArray. Nodes keep their indices so no link changes, the new nodes
+ * go to the free list.
+ */
+void IndexLinkedList::Resize(){
+	size_t higherCapacity = static_cast<size_t>(_capacity * (_delta + 1));
+	if (higherCapacity <= _capacity){
+		higherCapacity = _capacity + 1; // Small capacities would not grow otherwise
+	}
+	if (higherCapacity > NIL){
+		higherCapacity = NIL;
+	}
+	Node* tempData = new Node[higherCapacity];
+	for (size_t i = 0; i < _capacity; i++){
+		tempData[i] = _nodes[i];
+	}
+	LIST_STATS_ADD(resizes, 1);
+	LIST_STATS_ADD(bytesMoved, _capacity * sizeof(Node));
+	delete[] _nodes;
+	_nodes = tempData;
+	size_t from = _capacity;
+	_capacity = higherCapacity;
+	LinkFree(from);
+}
+/**
+ * Pushes the nodes from a given index to the end of the array into the
+ * free list, so the lowest index is handed out first.
+ * @param from the first node to release
+ */
+void IndexLinkedList::LinkFree(size_t from){
+	for (size_t i = _capacity; i > from; i--){
+		_nodes[i - 1].data = nullptr;
+		_nodes[i - 1].previous = NIL;
+		_nodes[i - 1].next = _free;
+		_free = static_cast<uint32_t>(i - 1);
+	}
+}
+/**
+ * Finds the node at a valid position, walking from the closest end
+ * @param position the position, must be less than the size
+ * @return the index of the node at that position
+ */
+uint32_t IndexLinkedList::At(size_t position)const{
+	uint32_t tmp = NIL;
+	if (position < _size / 2){
+		tmp = _head;
+		for (size_t i = 0; i < position; i++){
+			tmp = _nodes[tmp].next;
+		}
+		LIST_STATS_ADD(hops, position);
+	}else{
+		tmp = _tail;
+		for (size_t i = _size - 1; i > position; i--){
+			tmp = _nodes[tmp].previous;
+		}
+		LIST_STATS_ADD(hops, _size - 1 - position);
+	}
+	return tmp;
+}
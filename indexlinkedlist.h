@@ -0,0 +1,74 @@
+/*
+ * Title:		Index Linked List
+ * Purpose:		Declaration of a doubly linked list whose nodes live in one
+ * 				growable array and are linked by 32 bit indices instead of
+ * 				pointers. Released nodes are kept in a free list for reuse.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef INDEX_LINKED_LIST_H
+#define INDEX_LINKED_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <cstdint>
+#include <string>
+using std::string;
+
+class IndexLinkedList final : public List{
+	struct Node{
+		Object* data;
+		uint32_t next;
+		uint32_t previous;
+	};
+	// Marks the end of a chain, there is no node with this index
+	static const uint32_t NIL = 0xFFFFFFFF;
+
+	Node* _nodes;
+	size_t _capacity;
+	double _delta;
+	uint32_t _head;
+	uint32_t _tail;
+	uint32_t _free;		// First node of the free list, linked by next
+	IndexLinkedList(const IndexLinkedList&);
+	const IndexLinkedList& operator=(const IndexLinkedList&);
+	void Resize();
+	void LinkFree(size_t from);
+	uint32_t At(size_t position)const;
+public:
+	IndexLinkedList(size_t capacity = 16, double increasePercentage = 0.5);
+	virtual ~IndexLinkedList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+
+	void Compact();
+	size_t GetCapacity()const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+/**
+ * Visits the elements in list order without virtual dispatch.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool IndexLinkedList::Visit(Visitor visitor)const{
+	for (uint32_t tmp = _head; tmp != NIL; tmp = _nodes[tmp].next){
+		if (!visitor(_nodes[tmp].data)){
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
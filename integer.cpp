@@ -5,7 +5,9 @@
  * Date:		April 29, 2020
  */
 #include "integer.h"
+#include "objectcounters.h"
 
+#include <functional>
 #include <string>
 #include <sstream>
 using std::string;
@@ -20,7 +22,22 @@ using std::stringstream;
  * @param value the initial value of the integer value being wrapped
  */
 Integer::Integer(int value): _value(value){
-
+	OBJECT_COUNTERS_CREATED(TYPE_INTEGER, sizeof(Integer));
+}
+/**
+ * Copy constructor
+ * Copies the value, it only exists so copies are counted
+ * @param other the integer being copied
+ */
+Integer::Integer(const Integer& other) : Object(other), _value(other._value){
+	OBJECT_COUNTERS_CREATED(TYPE_INTEGER, sizeof(Integer));
+}
+/**
+ * Destructor
+ * Does not do anything besides counting
+ */
+Integer::~Integer(){
+	OBJECT_COUNTERS_DESTROYED(TYPE_INTEGER, sizeof(Integer));
 }
 /**
  * Creates a string representation of the integer.
@@ -52,6 +69,13 @@ bool Integer::Equals(const Object& rhs)const{
 	return _value == rhsPtr->_value;
 
 }
+/**
+ * Hash code consistent with Equals
+ * @return the hash of the integer value
+ */
+size_t Integer::Hash()const{
+	return std::hash<int>()(_value);
+}
 /**
  * Value accessor
  * @return the underlying integer value
@@ -72,4 +96,19 @@ void Integer::SetValue(int value){
  */
 Object* Integer::Clone()const{
 	return new Integer(_value);
+}
+/**
+ * Creates a copy of the integer in a memory resource
+ * @param resource where the copy is allocated
+ * @return a new copy of this
+ */
+Object* Integer::Clone(MemoryResource* resource)const{
+	return new (resource) Integer(_value);
+}
+/**
+ * Memory footprint
+ * @return the size of an integer wrapper in bytes
+ */
+size_t Integer::FootprintBytes()const{
+	return sizeof(Integer);
 }
\ No newline at end of file
@@ -16,11 +16,16 @@ class Integer : public Object{
 		int _value;
 	public:
 		Integer(int = 0);
+		Integer(const Integer& other);
+		virtual ~Integer();
 		virtual string ToString()const;
 		int GetValue()const;
 		void SetValue(int);
 		virtual bool Equals(const Object& rhs)const;
+		virtual size_t Hash()const;
 		virtual Object* Clone()const;
+		virtual Object* Clone(MemoryResource* resource)const;
+		virtual size_t FootprintBytes()const;
 };
 
 #endif /* end of include guard: INTEGER_H */
@@ -0,0 +1,272 @@
+/*
+ * Title:		Intrusive List
+ * Purpose:		Implementation of a doubly linked list that uses the hooks
+ * 				embedded in the elements as its nodes, inserting and removing
+ * 				never allocate and a known element is removed in constant time.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "intrusivelist.h"
+
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+/**
+ * Default Constructor
+ * A hook that is not linked to any list
+ */
+ListHook::ListHook() : _next(nullptr), _previous(nullptr), _object(nullptr), _list(nullptr){
+
+}
+/**
+ * Copy Constructor
+ * The copy of a linked element is not in the list, links are not copied
+ */
+ListHook::ListHook(const ListHook&) : _next(nullptr), _previous(nullptr), _object(nullptr), _list(nullptr){
+
+}
+/**
+ * Copy Assignment Operator
+ * Assigning an element does not change the list it is linked to
+ * @return this to follow chain assignment standard
+ */
+const ListHook& ListHook::operator=(const ListHook&){
+	return *this;
+}
+/**
+ * Destructor
+ * An element deleted while linked is removed from its list so the list
+ * never points to released memory
+ */
+ListHook::~ListHook(){
+	if (_list != nullptr){
+		_list->Detach(this);
+	}
+}
+/**
+ * Verifies if the element is in a list
+ * @return true if the hook is linked into an intrusive list
+ */
+bool ListHook::IsLinked()const{
+	return _list != nullptr;
+}
+/**
+ * Default constructor
+ * Just sets the head and tail to nullptr
+ */
+IntrusiveList::IntrusiveList() : _head(nullptr), _tail(nullptr){
+
+}
+/**
+ * Destructor
+ * Releases every element, same as Clear
+ */
+IntrusiveList::~IntrusiveList(){
+	Clear();
+}
+/**
+ * Inserts an element into a given position.
+ * Inserting at either end is constant time, otherwise the list is walked
+ * from the closest end. No memory is allocated.
+ * @param element what the client wants to insert, it must have a hook
+ * @param position the position where the element is to be inserted
+ * @return true if it was possible to insert, false if the position is invalid,
+ * the element has no hook or it is already linked into a list
+ */
+bool IntrusiveList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size || element == nullptr){
+		return false;
+	}
+	ListHook* hook = element->Hook();
+	if (hook == nullptr || hook->IsLinked()){
+		return false;
+	}
+	hook->_object = element;
+	hook->_list = this;
+	ListHook* successor = position == _size ? nullptr : At(position);
+	ListHook* predecessor = successor == nullptr ? _tail : successor->_previous;
+	hook->_next = successor;
+	hook->_previous = predecessor;
+	if (predecessor == nullptr){
+		_head = hook;
+	}else{
+		predecessor->_next = hook;
+	}
+	if (successor == nullptr){
+		_tail = hook;
+	}else{
+		successor->_previous = hook;
+	}
+	_size++;
+	return true;
+}
+/**
+ * Searches for the position of an element in the list.
+ * The method performs a linear search using Equals.
+ * @param element the object that the client is searching for.
+ * @return the position of the element if found, -1 otherwise.
+ */
+int IntrusiveList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	int index = 0;
+	for (ListHook* tmp = _head; tmp != nullptr; tmp = tmp->_next){
+		if (tmp->_object->Equals(*element)){
+			LIST_STATS_ADD(hops, index);
+			return index;
+		}
+		index++;
+	}
+	LIST_STATS_ADD(hops, index);
+	return -1;
+}
+/**
+ * Removes the element at position, when the position is valid. The
+ * element is unlinked but not released, the client owns it.
+ * @param position the position of the element to be removed.
+ * @return the pointer to the object in that position if the position was valid,
+ * nullptr otherwise
+ */
+Object* IntrusiveList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	ListHook* hook = At(position);
+	Object* retVal = hook->_object;
+	Detach(hook);
+	return retVal;
+}
+/**
+ * Element Access
+ * Walks from the closest end of the list to the position.
+ * @param position the position of the element to retrieve.
+ * @return a pointer to the element if the position is valid, nullptr otherwise
+ */
+Object* IntrusiveList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	if (position >= _size){
+		return nullptr;
+	}
+	return At(position)->_object;
+}
+/**
+ * Creates a string representation of the list, surrounding the elements
+ * with curly braces and separating them by comma. Example: {2, 6, 8}
+ * @return a string representation of the list
+ */
+string IntrusiveList::ToString()const{
+	stringstream retVal;
+	retVal << "{";
+	for (ListHook* tmp = _head; tmp != nullptr; tmp = tmp->_next){
+		retVal << tmp->_object->ToString() << (tmp->_next == nullptr ? "" : ", ");
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Releases all the elements of the list. Each element is unlinked before
+ * it is deleted so its hook does not try to remove it again.
+ */
+void IntrusiveList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	while (_head != nullptr){
+		Object* element = _head->_object;
+		Detach(_head);
+		delete element;
+	}
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool IntrusiveList::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Memory usage breakdown
+ * There is no storage besides the list, the hooks are part of the
+ * elements' footprint.
+ * @return the bytes used by the list and its elements
+ */
+ListMemoryUsage IntrusiveList::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(IntrusiveList);
+	for (ListHook* tmp = _head; tmp != nullptr; tmp = tmp->_next){
+		retVal.elements += tmp->_object->FootprintBytes();
+	}
+	return retVal;
+}
+/**
+ * Removes a known element from the list in constant time, without
+ * searching for it. The element is not released.
+ * @param element the element to remove
+ * @return true if the element was in this list, false otherwise
+ */
+bool IntrusiveList::Unlink(Object* element){
+	if (!Contains(element)){
+		return false;
+	}
+	Detach(element->Hook());
+	return true;
+}
+/**
+ * Verifies in constant time if an element is linked into this list
+ * @param element the element
+ * @return true if the element is in this list
+ */
+bool IntrusiveList::Contains(Object* element)const{
+	if (element == nullptr){
+		return false;
+	}
+	ListHook* hook = element->Hook();
+	return hook != nullptr && hook->_list == this;
+}
+/**
+ * Finds the hook at a valid position, walking from the closest end
+ * @param position the position, must be less than the size
+ * @return the hook at that position
+ */
+ListHook* IntrusiveList::At(size_t position)const{
+	ListHook* tmp = nullptr;
+	if (position < _size / 2){
+		tmp = _head;
+		for (size_t i = 0; i < position; i++){
+			tmp = tmp->_next;
+		}
+		LIST_STATS_ADD(hops, position);
+	}else{
+		tmp = _tail;
+		for (size_t i = _size - 1; i > position; i--){
+			tmp = tmp->_previous;
+		}
+		LIST_STATS_ADD(hops, _size - 1 - position);
+	}
+	return tmp;
+}
+/**
+ * Unlinks a hook that belongs to this list and clears its links
+ * @param hook the hook to unlink
+ */
+void IntrusiveList::Detach(ListHook* hook){
+	if (hook->_previous == nullptr){
+		_head = hook->_next;
+	}else{
+		hook->_previous->_next = hook->_next;
+	}
+	if (hook->_next == nullptr){
+		_tail = hook->_previous;
+	}else{
+		hook->_next->_previous = hook->_previous;
+	}
+	hook->_next = nullptr;
+	hook->_previous = nullptr;
+	hook->_object = nullptr;
+	hook->_list = nullptr;
+	_size--;
+}
@@ -0,0 +1,106 @@
+/*
+ * Title:		Intrusive List
+ * Purpose:		Declaration of a doubly linked list whose links live inside
+ * 				the elements. An element can be inserted if it carries a
+ * 				ListHook and returns it from Object::Hook(); Linkable<T> adds
+ * 				one to any copyable Object subclass, for example
+ * 				Linkable<Integer> or Linkable<Person>.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <string>
+using std::string;
+
+class IntrusiveList;
+
+/**
+ * The links of an element. Copies of an element are never linked, and an
+ * element that is destroyed while linked removes itself from its list.
+ */
+class ListHook{
+	friend class IntrusiveList;
+	ListHook* _next;
+	ListHook* _previous;
+	Object* _object;
+	IntrusiveList* _list;
+public:
+	ListHook();
+	ListHook(const ListHook&);
+	const ListHook& operator=(const ListHook&);
+	~ListHook();
+	bool IsLinked()const;
+};
+
+/**
+ * Adds a ListHook to an existing element type, the constructors of the
+ * type are inherited.
+ */
+template <class T>
+class Linkable : public T{
+	ListHook _hook;
+public:
+	using T::T;
+	virtual ListHook* Hook(){
+		return &_hook;
+	}
+	virtual Object* Clone()const{
+		return new Linkable<T>(*this);
+	}
+	virtual Object* Clone(MemoryResource* resource)const{
+		return new (resource) Linkable<T>(*this);
+	}
+	virtual size_t FootprintBytes()const{
+		return T::FootprintBytes() + sizeof(Linkable<T>) - sizeof(T);
+	}
+};
+
+class IntrusiveList final : public List{
+	friend class ListHook;
+	ListHook* _head;
+	ListHook* _tail;
+	IntrusiveList(const IntrusiveList&);
+	const IntrusiveList& operator=(const IntrusiveList&);
+	ListHook* At(size_t position)const;
+	void Detach(ListHook* hook);
+public:
+	IntrusiveList();
+	virtual ~IntrusiveList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+
+	bool Unlink(Object* element);
+	bool Contains(Object* element)const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+/**
+ * Visits the elements in order without virtual dispatch.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool IntrusiveList::Visit(Visitor visitor)const{
+	for (ListHook* tmp = _head; tmp != nullptr; tmp = tmp->_next){
+		if (!visitor(tmp->_object)){
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
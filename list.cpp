@@ -6,20 +6,170 @@
  */
 
 #include "list.h"
+#include "editbatch.h"
+
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <utility>
+using std::string;
+using std::stringstream;
+
+namespace{
+	const size_t HASHED_KEYS = 4;	// Fewer keys are compared with every element
+
+	/**
+	 * Matches the elements of a list with a set of keys, element->Equals(key)
+	 * as IndexOf does. With HASHED_KEYS keys or more the keys are sorted by
+	 * Hash, and an element is only compared with the keys of the same hash:
+	 * one Hash call per element instead of one Equals call per key.
+	 */
+	class KeyMatcher{
+		typedef std::pair<size_t, size_t> HashedKey;	// Hash and index of a key
+		const Object* const* _keys;
+		vector<HashedKey> _hashed;
+		vector<size_t> _plain;							// Keys compared with every element
+	public:
+		KeyMatcher(const Object* const* keys, const vector<bool>& active) : _keys(keys){
+			for (size_t i = 0; i < active.size(); i++){
+				if (active[i]){
+					_plain.push_back(i);
+				}
+			}
+			if (_plain.size() >= HASHED_KEYS){
+				for (size_t key : _plain){
+					_hashed.push_back(HashedKey(keys[key]->Hash(), key));
+				}
+				std::sort(_hashed.begin(), _hashed.end());
+				_plain.clear();
+			}
+		}
+		bool IsEmpty()const{
+			return _plain.empty() && _hashed.empty();
+		}
+		/**
+		 * Calls match(key) for every key equal to element
+		 */
+		template <class Function>
+		void Match(const Object* element, Function match)const{
+			for (size_t key : _plain){
+				if (element->Equals(*_keys[key])){
+					match(key);
+				}
+			}
+			if (_hashed.empty()){
+				return;
+			}
+			size_t hash = element->Hash();
+			vector<HashedKey>::const_iterator it = std::lower_bound(_hashed.begin(), _hashed.end(), HashedKey(hash, 0));
+			for (; it != _hashed.end() && it->first == hash; ++it){
+				if (element->Equals(*_keys[it->second])){
+					match(it->second);
+				}
+			}
+		}
+	};
+
+	/**
+	 * Records the first position of every key, stops once all are found
+	 */
+	class FirstVisitor : public ElementVisitor{
+		const KeyMatcher& _matcher;
+		vector<int>& _positions;
+		size_t _missing;
+		int _position;
+	public:
+		FirstVisitor(const KeyMatcher& matcher, vector<int>& positions, size_t missing) : _matcher(matcher),
+			_positions(positions), _missing(missing), _position(0){
+
+		}
+		virtual bool Visit(Object* element){
+			_matcher.Match(element, [this](size_t key){
+				if (_positions[key] < 0){
+					_positions[key] = _position;
+					_missing--;
+				}
+			});
+			_position++;
+			return _missing > 0;
+		}
+	};
+
+	/**
+	 * Counts the elements equal to a key and remembers the last one, and
+	 * every position when positions is not nullptr
+	 */
+	class AllVisitor : public ElementVisitor{
+		const Object& _key;
+		vector<size_t>* _positions;
+		size_t _position;
+	public:
+		size_t count;
+		int last;
+		AllVisitor(const Object& key, vector<size_t>* positions) : _key(key), _positions(positions), _position(0),
+			count(0), last(-1){
+
+		}
+		virtual bool Visit(Object* element){
+			if (element->Equals(_key)){
+				count++;
+				last = static_cast<int>(_position);
+				if (_positions != nullptr){
+					_positions->push_back(_position);
+				}
+			}
+			_position++;
+			return true;
+		}
+	};
+}
+
+/**
+ * Destructor
+ * Only needed to make it virtual
+ */
+ElementVisitor::~ElementVisitor(){
+
+}
+
+/**
+ * Default Constructor
+ * Starts with every category in zero
+ */
+ListMemoryUsage::ListMemoryUsage() : container(0), storage(0), unused(0), elements(0){
+
+}
+/**
+ * Adds up all the categories
+ * @return the total number of bytes
+ */
+size_t ListMemoryUsage::Total()const{
+	return container + storage + unused + elements;
+}
+/**
+ * Creates a string representation of the breakdown in JSON format
+ * @return a string with the bytes of each category and the total
+ */
+string ListMemoryUsage::ToString()const{
+	stringstream retVal;
+	retVal << "{container: " << container << ", storage: " << storage << ", unused: " << unused
+		<< ", elements: " << elements << ", total: " << Total() << "}";
+	return retVal.str();
+}
 /**
  * Default Constructor
- * Just initializes the size to zero
+ * Just initializes the size to zero, elements are freed in place
  */
-List::List() : _size(0){
+List::List() : _size(0), _reclaimer(nullptr), _filter(nullptr), _version(0){
 
 }
 /**
  * Destructor
- * It does not do anything, needs to be in the base
- * class to activate polymorphism
+ * Releases the filter, needs to be in the base class to activate
+ * polymorphism
  */
 List::~List(){
-
+	delete _filter;
 }
 /**
  * Size accessor
@@ -35,3 +185,326 @@ size_t List::Size()const{
 bool List::IsEmpty()const{
 	return _size == 0;
 }
+/**
+ * Statistics snapshot
+ * When the library is built without LIST_STATS nothing is recorded and
+ * the snapshot has all the counters in zero.
+ * @return a copy of the operation counters and latency histograms
+ */
+ListStats List::Stats()const{
+#ifdef LIST_STATS
+	return _stats;
+#else
+	return ListStats();
+#endif
+}
+/**
+ * Version accessor
+ * VSArray, DoubleLinkedList and StaticArrayList change the version on
+ * every insertion and removal, views and edit batches compare it with the
+ * version they were created at to detect changes to the list.
+ * @return the current version of the list
+ */
+unsigned long long List::GetVersion()const{
+	return _version;
+}
+/**
+ * Sets all the statistics of the list back to zero
+ */
+void List::ResetStats(){
+#ifdef LIST_STATS
+	_stats.Reset();
+#endif
+}
+/**
+ * Opts the list into deferred destruction. Lists that support it (VSArray
+ * and DoubleLinkedList) detach their storage on Clear and destruction and
+ * hand it to the reclaimer, which must outlive the list.
+ * @param reclaimer the reclaimer to use, nullptr to free in place again
+ */
+void List::SetReclaimer(Reclaimer* reclaimer){
+	_reclaimer = reclaimer;
+}
+/**
+ * Reclaimer accessor
+ * @return the reclaimer of the list, nullptr if elements are freed in place
+ */
+Reclaimer* List::GetReclaimer()const{
+	return _reclaimer;
+}
+/**
+ * Turns on the Bloom filter that lets IndexOf return -1 without scanning
+ * when an element is certainly absent. Lists that support it keep it up to
+ * date on Insert and rebuild it lazily after removals, on the other lists
+ * it does nothing. Elements must implement Hash consistently with Equals.
+ * @param expected the number of elements to size the filter for, it
+ * grows with the list
+ */
+void List::EnableFilter(size_t expected){
+	if (!SupportsFilter()){
+		return;
+	}
+	delete _filter;
+	_filter = new BloomFilter(expected > _size ? expected : _size);
+	FillFilter();
+}
+/**
+ * Turns off the filter and forgets its counters
+ */
+void List::DisableFilter(){
+	delete _filter;
+	_filter = nullptr;
+}
+/**
+ * Checks if the list keeps a filter up to date, lists that do override it
+ * @return false, EnableFilter does nothing on this list
+ */
+bool List::SupportsFilter()const{
+	return false;
+}
+/**
+ * Filter accessor
+ * @return true if IndexOf consults a filter
+ */
+bool List::HasFilter()const{
+	return _filter != nullptr;
+}
+/**
+ * Filter counters accessor
+ * @return what the filter did for IndexOf, all zero without a filter
+ */
+FilterStats List::GetFilterStats()const{
+	return _filter == nullptr ? FilterStats() : _filter->stats;
+}
+/**
+ * Adds every element to the filter. Works for any list through Walk, the
+ * lists that support filters override it with a direct traversal.
+ */
+void List::FillFilter()const{
+	class FilterVisitor : public ElementVisitor{
+		BloomFilter& _filter;
+	public:
+		explicit FilterVisitor(BloomFilter& filter) : _filter(filter){
+
+		}
+		virtual bool Visit(Object* element){
+			_filter.Add(element->Hash());
+			return true;
+		}
+	} visitor(*_filter);
+	Walk(visitor);
+}
+/**
+ * Calls visitor.Visit with every element in order until it returns false.
+ * This version goes through Get, lists override it with a traversal that
+ * does not look up every position.
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool List::Walk(ElementVisitor& visitor)const{
+	for (size_t i = 0; i < _size; i++){
+		if (!visitor.Visit(Get(i))){
+			return false;
+		}
+	}
+	return true;
+}
+/**
+ * Answers IndexOf for several keys in one traversal. Keys the filter
+ * excludes are not looked for, the traversal stops once every key is found.
+ * Lists that do not store their elements as objects override it and the
+ * other queries below to compare the keys with what they store.
+ * @param keys the keys, nullptr keys are never found
+ * @param count the number of keys
+ * @return the position of the first element equal to each key, -1 for the
+ * keys that are not in the list
+ */
+vector<int> List::IndexOfAny(const Object* const* keys, size_t count)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	vector<int> retVal(count, -1);
+	vector<bool> active(count);
+	size_t missing = 0;
+	for (size_t i = 0; i < count; i++){
+		active[i] = keys[i] != nullptr && !FilterExcludes(keys[i]);
+		missing += active[i];
+	}
+	KeyMatcher matcher(keys, active);
+	if (!matcher.IsEmpty()){
+		FirstVisitor visitor(matcher, retVal, missing);
+		Walk(visitor);
+	}
+	for (size_t i = 0; i < count; i++){
+		if (active[i] && retVal[i] < 0){
+			FilterMissed();
+		}
+	}
+	return retVal;
+}
+/**
+ * Number of elements equal to element, in one traversal
+ * @return 0 if there is none
+ */
+size_t List::CountOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (element == nullptr || FilterExcludes(element)){
+		return 0;
+	}
+	AllVisitor visitor(*element, nullptr);
+	Walk(visitor);
+	if (visitor.count == 0){
+		FilterMissed();
+	}
+	return visitor.count;
+}
+/**
+ * Position of the last element equal to element, in one traversal
+ * @return the position, -1 if there is none
+ */
+int List::LastIndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (element == nullptr || FilterExcludes(element)){
+		return -1;
+	}
+	AllVisitor visitor(*element, nullptr);
+	Walk(visitor);
+	if (visitor.count == 0){
+		FilterMissed();
+	}
+	return visitor.last;
+}
+/**
+ * Positions of every element equal to element, in one traversal
+ * @return the positions in increasing order, empty if there is none
+ */
+vector<size_t> List::FindAll(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	vector<size_t> retVal;
+	if (element == nullptr || FilterExcludes(element)){
+		return retVal;
+	}
+	AllVisitor visitor(*element, &retVal);
+	Walk(visitor);
+	if (visitor.count == 0){
+		FilterMissed();
+	}
+	return retVal;
+}
+/**
+ * Rebuilds the filter from the current elements, sized for at least
+ * twice the current size
+ */
+void List::RebuildFilter()const{
+	const size_t MINIMUM = 64;
+	_filter->Reset(_size < MINIMUM ? MINIMUM : 2 * _size);
+	FillFilter();
+	_filter->stats.rebuilds++;
+}
+/**
+ * Memory footprint of the filter, counted with the list object
+ * @return the bytes of the filter, zero without one
+ */
+size_t List::FilterBytes()const{
+	return _filter == nullptr ? 0 : _filter->MemoryBytes();
+}
+/**
+ * Inserts count elements so that the first one ends up at position and
+ * the rest follow it in order. This version inserts them one by one,
+ * lists override it to make room for all of them at once.
+ * @param elements the elements to insert, the list owns the ones inserted
+ * @param count the number of elements
+ * @param position where the first element goes
+ * @return the number of elements inserted, 0 if the position is invalid
+ */
+size_t List::InsertRange(Object* const* elements, size_t count, size_t position){
+	size_t retVal = 0;
+	while (retVal < count && Insert(elements[retVal], position + retVal)){
+		retVal++;
+	}
+	return retVal;
+}
+/**
+ * Applies a batch of edits recorded against the current state of the list.
+ * This version removes the elements that do not survive from the last one
+ * to the first, so the positions of the rest do not change, and then
+ * inserts the new elements in the order of their final positions. Lists
+ * override it to do it in one pass.
+ * When the list refuses an element (it is full, or cannot store that kind
+ * of element) the edits are undone: the elements inserted so far are
+ * removed and the removed elements go back to their positions. The list
+ * then holds the elements it had before the batch.
+ * @param batch the pieces of the list after the edits
+ * @param removed where the removed elements are written, in the order of
+ * their positions before the edits
+ * @return false if an element was refused, the elements the batch inserts
+ * are deleted then and the removed elements are back in the list
+ */
+bool List::ApplyBatch(const EditBatch& batch, Object** removed){
+	const vector<EditBatch::Piece>& pieces = batch.Pieces();
+	// The runs of pieces survive, the positions in between are removed
+	size_t gaps = batch.OriginalSize();
+	for (const EditBatch::Piece& piece : pieces){
+		if (piece.element == nullptr){
+			gaps -= piece.count;
+		}
+	}
+	size_t end = batch.OriginalSize();
+	for (size_t i = pieces.size(); i > 0; i--){
+		const EditBatch::Piece& piece = pieces[i - 1];
+		if (piece.element == nullptr){
+			while (end > piece.first + piece.count){
+				removed[--gaps] = Remove(--end);
+			}
+			end = piece.first;
+		}
+	}
+	while (end > 0){
+		removed[--gaps] = Remove(--end);
+	}
+	size_t position = 0;
+	size_t refused = 0;
+	for (; refused < pieces.size(); refused++){
+		const EditBatch::Piece& piece = pieces[refused];
+		if (piece.element != nullptr && !Insert(piece.element, position)){
+			break;
+		}
+		position += piece.count;
+	}
+	if (refused == pieces.size()){
+		return true;
+	}
+	// Lists that encode their elements already deleted the ones they took,
+	// Remove hands back a copy of them
+	for (size_t i = refused; i < pieces.size(); i++){
+		delete pieces[i].element;
+	}
+	for (size_t i = refused; i > 0; i--){
+		const EditBatch::Piece& piece = pieces[i - 1];
+		position -= piece.count;
+		if (piece.element != nullptr){
+			delete Remove(position);
+		}
+	}
+	// The runs are in the order of their first position, the list held the
+	// removed elements before so there is room for them
+	position = 0;
+	for (const EditBatch::Piece& piece : pieces){
+		if (piece.element == nullptr){
+			for (; position < piece.first; position++){
+				Insert(removed[gaps++], position);
+			}
+			position = piece.first + piece.count;
+		}
+	}
+	for (; position < batch.OriginalSize(); position++){
+		Insert(removed[gaps++], position);
+	}
+	return false;
+}
+/**
+ * Memory footprint
+ * A list is also an object, it uses the bytes reported by MemoryUsage
+ * @return the total bytes used by the list and its elements
+ */
+size_t List::FootprintBytes()const{
+	return MemoryUsage().Total();
+}
@@ -8,16 +8,62 @@
 #define LIST_H
 
 #include "object.h"
+#include "liststats.h"
+#include "bloomfilter.h"
+
+class Reclaimer;
+class EditBatch;
 
 #include <string>
 #include <iostream>
+#include <vector>
 using std::string;
 using std::istream;
 using std::ostream;
+using std::vector;
+
+/**
+ * Bytes used by a list, split by what they are used for. Allocator
+ * bookkeeping (malloc headers, rounding) is not included.
+ */
+struct ListMemoryUsage{
+	size_t container;	// The list object itself
+	size_t storage;		// Array slots or nodes holding the elements
+	size_t unused;		// Allocated capacity that holds no element
+	size_t elements;	// FootprintBytes of every element
+	ListMemoryUsage();
+	size_t Total()const;
+	string ToString()const;
+};
+
+/**
+ * Receives the elements of a list from List::Walk, in order
+ */
+class ElementVisitor{
+public:
+	virtual ~ElementVisitor();
+	virtual bool Visit(Object* element) = 0;	// false stops the walk
+};
 
 class List : public Object{
 protected:			// Protected to be able to increase size on insert
 	size_t _size;
+	Reclaimer* _reclaimer;		// Deferred destruction, nullptr frees in place
+	BloomFilter* _filter;		// Negative IndexOf filter, nullptr when disabled
+	unsigned long long _version;	// Changes whenever VSArray, DoubleLinkedList or StaticArrayList change
+#ifdef LIST_STATS
+	mutable ListStats _stats;	// Mutable so const accessors can be counted
+#endif
+	virtual void FillFilter()const;
+	void RebuildFilter()const;
+	bool FilterExcludes(const Object* element)const;
+	void FilterMissed()const;
+	void FilterAdd(const Object* element);
+	void FilterRemoved();
+	void FilterInvalidate();
+	size_t FilterBytes()const;
+	virtual bool ApplyBatch(const EditBatch& batch, Object** removed);
+	friend class EditBatch;
 public:
 	List();
 	virtual ~List();
@@ -28,11 +74,82 @@ public:
 	virtual Object* Get(size_t position)const = 0;
 	virtual string ToString()const = 0;
 	virtual void Clear() = 0;
+	virtual ListMemoryUsage MemoryUsage()const = 0;
+	virtual size_t FootprintBytes()const;
+	virtual size_t InsertRange(Object* const* elements, size_t count, size_t position);
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+
+	virtual vector<int> IndexOfAny(const Object* const* keys, size_t count)const;
+	virtual size_t CountOf(const Object* element)const;
+	virtual int LastIndexOf(const Object* element)const;
+	virtual vector<size_t> FindAll(const Object* element)const;
 
 	size_t Size()const;
 	bool IsEmpty()const;
+	unsigned long long GetVersion()const;
+	ListStats Stats()const;
+	void ResetStats();
+	void SetReclaimer(Reclaimer* reclaimer);
+	Reclaimer* GetReclaimer()const;
+	void EnableFilter(size_t expected = 1024);
+	void DisableFilter();
+	bool HasFilter()const;
+	FilterStats GetFilterStats()const;
 
 };
 
+/**
+ * Skips the scan of IndexOf when the filter knows the element is absent.
+ * Rebuilds a stale filter first.
+ * @param element the element IndexOf is looking for
+ * @return true if the element is certainly not in the list
+ */
+inline bool List::FilterExcludes(const Object* element)const{
+	if (_filter == nullptr || element == nullptr){
+		return false;
+	}
+	if (_filter->NeedsRebuild()){
+		RebuildFilter();
+	}
+	if (!_filter->MayContain(element->Hash())){
+		_filter->stats.hits++;
+		return true;
+	}
+	_filter->stats.misses++;
+	return false;
+}
+/**
+ * Called when the scan that the filter let through found nothing
+ */
+inline void List::FilterMissed()const{
+	if (_filter != nullptr){
+		_filter->stats.falsePositives++;
+	}
+}
+/**
+ * Called after an element was inserted
+ */
+inline void List::FilterAdd(const Object* element){
+	if (_filter != nullptr){
+		_filter->Add(element->Hash());
+	}
+}
+/**
+ * Called after an element was removed
+ */
+inline void List::FilterRemoved(){
+	if (_filter != nullptr){
+		_filter->NoteRemoval();
+	}
+}
+/**
+ * Called when elements were added or removed in bulk (Clear, Splice...)
+ */
+inline void List::FilterInvalidate(){
+	if (_filter != nullptr){
+		_filter->Invalidate();
+	}
+}
 
 #endif
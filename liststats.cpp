@@ -0,0 +1,139 @@
+/*
+ * Title:		List Statistics
+ * Purpose:		Definition of the operation counters, latency histograms and
+ * 				their text and JSON dumps
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "liststats.h"
+
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+/**
+ * Default Constructor
+ * Starts with all the counters in zero
+ */
+ListStats::ListStats(){
+	Reset();
+}
+/**
+ * Sets all the counters and histogram buckets back to zero
+ */
+void ListStats::Reset(){
+	for (size_t op = 0; op < OPERATION_COUNT; op++){
+		calls[op] = 0;
+		for (size_t b = 0; b < BUCKETS; b++){
+			latency[op][b] = 0;
+		}
+	}
+	shifts = 0;
+	hops = 0;
+	resizes = 0;
+	bytesMoved = 0;
+}
+/**
+ * Counts one call of the operation and adds its latency to the histogram
+ * @param operation the operation that was executed
+ * @param nanoseconds how long the operation took
+ */
+void ListStats::Record(Operation operation, unsigned long long nanoseconds){
+	calls[operation]++;
+	latency[operation][Bucket(nanoseconds)]++;
+}
+/**
+ * Finds the logarithmic bucket for a latency, the last bucket also
+ * holds everything that does not fit in the others.
+ * @param nanoseconds the latency
+ * @return the index of the bucket, floor(log2(nanoseconds))
+ */
+size_t ListStats::Bucket(unsigned long long nanoseconds){
+	size_t bucket = 0;
+	while (nanoseconds > 1 && bucket < BUCKETS - 1){
+		nanoseconds >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+/**
+ * Name of an operation, as used in the dumps
+ * @param operation the operation
+ * @return the name of the List method
+ */
+const char* ListStats::OperationName(Operation operation){
+	switch (operation){
+		case INSERT:	return "Insert";
+		case REMOVE:	return "Remove";
+		case GET:		return "Get";
+		case INDEX_OF:	return "IndexOf";
+		case CLEAR:		return "Clear";
+		default:		return "Unknown";
+	}
+}
+/**
+ * Creates a human readable dump of the counters. Only the non empty
+ * histogram buckets are printed, each one as [low ns, high ns): count
+ * @return a multi line string with the statistics
+ */
+string ListStats::ToString()const{
+	stringstream retVal;
+	for (size_t op = 0; op < OPERATION_COUNT; op++){
+		retVal << OperationName(static_cast<Operation>(op)) << ": " << calls[op] << " calls";
+		for (size_t b = 0; b < BUCKETS; b++){
+			if (latency[op][b] != 0){
+				retVal << " [" << (1ULL << b) << "ns, " << (2ULL << b) << "ns): " << latency[op][b];
+			}
+		}
+		retVal << "\n";
+	}
+	retVal << "shifts: " << shifts << "\n";
+	retVal << "hops: " << hops << "\n";
+	retVal << "resizes: " << resizes << "\n";
+	retVal << "bytes moved: " << bytesMoved << "\n";
+	return retVal.str();
+}
+/**
+ * Creates a JSON dump of the counters. The histograms are written as
+ * arrays with one entry per bucket so they can be plotted directly.
+ * @return a JSON object with the statistics
+ */
+string ListStats::ToJson()const{
+	stringstream retVal;
+	retVal << "{\"operations\": {";
+	for (size_t op = 0; op < OPERATION_COUNT; op++){
+		if (op != 0){
+			retVal << ", ";
+		}
+		retVal << "\"" << OperationName(static_cast<Operation>(op)) << "\": {\"calls\": " << calls[op];
+		retVal << ", \"latencyLog2Ns\": [";
+		for (size_t b = 0; b < BUCKETS; b++){
+			retVal << (b == 0 ? "" : ", ") << latency[op][b];
+		}
+		retVal << "]}";
+	}
+	retVal << "}, \"shifts\": " << shifts;
+	retVal << ", \"hops\": " << hops;
+	retVal << ", \"resizes\": " << resizes;
+	retVal << ", \"bytesMoved\": " << bytesMoved << "}";
+	return retVal.str();
+}
+/**
+ * Constructor
+ * Starts the clock for the operation
+ * @param stats where the call will be recorded
+ * @param operation the operation being timed
+ */
+ListStatsScope::ListStatsScope(ListStats& stats, ListStats::Operation operation) :
+		_stats(stats), _operation(operation), _start(std::chrono::steady_clock::now()){
+
+}
+/**
+ * Destructor
+ * Stops the clock and records the call
+ */
+ListStatsScope::~ListStatsScope(){
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - _start;
+	_stats.Record(_operation, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
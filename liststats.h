@@ -0,0 +1,71 @@
+/*
+ * Title:		List Statistics
+ * Purpose:		Declaration of the opt-in operation counters and latency
+ * 				histograms that the concrete lists feed. The recording macros
+ * 				compile to nothing unless LIST_STATS is defined.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+using std::string;
+
+struct ListStats{
+	enum Operation{
+		INSERT,
+		REMOVE,
+		GET,
+		INDEX_OF,
+		CLEAR,
+		OPERATION_COUNT
+	};
+	// Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds
+	static const size_t BUCKETS = 32;
+
+	unsigned long long calls[OPERATION_COUNT];
+	unsigned long long latency[OPERATION_COUNT][BUCKETS];
+	unsigned long long shifts;		// Elements moved one slot by VSArray
+	unsigned long long hops;		// Node links followed by DoubleLinkedList
+	unsigned long long resizes;		// Calls to VSArray::Resize
+	unsigned long long bytesMoved;	// Bytes copied by resizes
+
+	ListStats();
+	void Reset();
+	void Record(Operation operation, unsigned long long nanoseconds);
+	string ToString()const;
+	string ToJson()const;
+
+	static const char* OperationName(Operation operation);
+	static size_t Bucket(unsigned long long nanoseconds);
+};
+
+/**
+ * Scoped timer, counts one call of an operation and records its latency
+ * when it goes out of scope.
+ */
+class ListStatsScope{
+	ListStats& _stats;
+	ListStats::Operation _operation;
+	std::chrono::steady_clock::time_point _start;
+	ListStatsScope(const ListStatsScope&);
+	const ListStatsScope& operator=(const ListStatsScope&);
+public:
+	ListStatsScope(ListStats& stats, ListStats::Operation operation);
+	~ListStatsScope();
+};
+
+#ifdef LIST_STATS
+#define LIST_STATS_SCOPE(operation) ListStatsScope _statsScope(_stats, ListStats::operation)
+#define LIST_STATS_ADD(field, amount) (_stats.field += (amount))
+#define LIST_STATS_ADD_TO(list, field, amount) ((list)._stats.field += (amount))
+#else
+#define LIST_STATS_SCOPE(operation) ((void)0)
+#define LIST_STATS_ADD(field, amount) ((void)0)
+#define LIST_STATS_ADD_TO(list, field, amount) ((void)0)
+#endif
+
+#endif
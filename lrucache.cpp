@@ -0,0 +1,224 @@
+/*
+ * Title:		LRU Cache
+ * Purpose:		Implementation of the least recently used cache. Every entry
+ * 				is a node of the recency list holding the key and an index
+ * 				entry holding the node and the value.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "lrucache.h"
+
+#include <sstream>
+using std::stringstream;
+
+/**
+ * Constructor
+ * All the counters start at zero
+ */
+CacheStats::CacheStats() : hits(0), misses(0), insertions(0), evictions(0){
+
+}
+/**
+ * Hit rate accessor
+ * @return the fraction of the lookups that found their key, 0 without lookups
+ */
+double CacheStats::HitRate()const{
+	return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+}
+/**
+ * Creates a string representation of the counters in JSON format
+ * @return a string with every counter
+ */
+string CacheStats::ToString()const{
+	stringstream retVal;
+	retVal << "{hits: " << hits << ", misses: " << misses << ", insertions: " << insertions
+		<< ", evictions: " << evictions << "}";
+	return retVal.str();
+}
+
+size_t LruCache::KeyHash::operator()(const Object* key)const{
+	return key->Hash();
+}
+bool LruCache::KeyEquals::operator()(const Object* lhs, const Object* rhs)const{
+	return lhs == rhs || lhs->Equals(*rhs);
+}
+
+/**
+ * Constructor
+ * @param capacity the maximum number of entries, 0 for no limit
+ * @param byteLimit the maximum bytes of the keys and values, 0 for no limit
+ */
+LruCache::LruCache(size_t capacity, size_t byteLimit) : _capacity(capacity), _byteLimit(byteLimit), _bytes(0){
+
+}
+/**
+ * Destructor
+ * Deletes the values, the recency list deletes the keys
+ */
+LruCache::~LruCache(){
+	for (Index::iterator it = _index.begin(); it != _index.end(); ++it){
+		delete it->second.value;
+	}
+}
+/**
+ * Inserts or replaces an entry and makes it the most recently used. The
+ * least recently used entries are evicted to stay within the limits.
+ * @param key the key, owned by the cache, deleted if the key is already there
+ * @param value the value, owned by the cache, replaces the current value
+ * @return false if the key or value is nullptr or the entry alone is above
+ * the byte limit, the caller keeps both then
+ */
+bool LruCache::Put(Object* key, Object* value){
+	if (key == nullptr || value == nullptr){
+		return false;
+	}
+	size_t bytes = key->FootprintBytes() + value->FootprintBytes();
+	if (_byteLimit != 0 && bytes > _byteLimit){
+		return false;
+	}
+	Index::iterator found = _index.find(key);
+	if (found != _index.end()){
+		Entry& entry = found->second;
+		size_t replaced = entry.node->data->FootprintBytes() + value->FootprintBytes();
+		_bytes = _bytes - entry.bytes + replaced;
+		entry.bytes = replaced;
+		delete entry.value;
+		delete key;
+		entry.value = value;
+		_recency.MoveToFront(entry.node);
+		Evict(0, 0);
+		return true;
+	}
+	// Makes room first, the new entry is never the one evicted
+	Evict(1, bytes);
+	_recency.Insert(key, 0);
+	Entry entry = {_recency._head, value, bytes};
+	_index.insert(Index::value_type(key, entry));
+	_bytes += bytes;
+	_stats.insertions++;
+	return true;
+}
+/**
+ * Looks up a key and makes its entry the most recently used
+ * @param key the key to look for, any object equal to the stored key
+ * @return the value, owned by the cache, nullptr if the key is not there
+ */
+Object* LruCache::Get(const Object& key){
+	Index::iterator found = _index.find(&key);
+	if (found == _index.end()){
+		_stats.misses++;
+		return nullptr;
+	}
+	_stats.hits++;
+	_recency.MoveToFront(found->second.node);
+	return found->second.value;
+}
+/**
+ * Looks up a key without changing the recency order or the statistics
+ * @return the value, owned by the cache, nullptr if the key is not there
+ */
+const Object* LruCache::Peek(const Object& key)const{
+	Index::const_iterator found = _index.find(&key);
+	return found == _index.end() ? nullptr : found->second.value;
+}
+bool LruCache::Contains(const Object& key)const{
+	return _index.find(&key) != _index.end();
+}
+/**
+ * Deletes an entry
+ * @param key the key of the entry
+ * @return false if the key is not there
+ */
+bool LruCache::Erase(const Object& key){
+	Index::iterator found = _index.find(&key);
+	if (found == _index.end()){
+		return false;
+	}
+	Drop(found);
+	return true;
+}
+/**
+ * Deletes every entry, the statistics are kept
+ */
+void LruCache::Clear(){
+	for (Index::iterator it = _index.begin(); it != _index.end(); ++it){
+		delete it->second.value;
+	}
+	_index.clear();
+	_recency.Clear();
+	_bytes = 0;
+}
+/**
+ * Evicts the least recently used entries until there is room within the limits
+ * @param entries the entries that will be added
+ * @param bytes the bytes that will be added
+ */
+void LruCache::Evict(size_t entries, size_t bytes){
+	while (!_index.empty() && ((_capacity != 0 && _index.size() + entries > _capacity) ||
+		(_byteLimit != 0 && _bytes + bytes > _byteLimit))){
+		Drop(_index.find(_recency._tail->data));
+		_stats.evictions++;
+	}
+}
+/**
+ * Deletes an entry, its key, its value and its node
+ * @param entry the entry in the index
+ */
+void LruCache::Drop(Index::iterator entry){
+	Object* value = entry->second.value;
+	DoubleLinkedList::Node* node = entry->second.node;
+	_bytes -= entry->second.bytes;
+	// The index refers to the key, erase it before the key is deleted
+	_index.erase(entry);
+	delete _recency.Unlink(node);
+	delete value;
+}
+/**
+ * Size accessor
+ * @return the number of entries
+ */
+size_t LruCache::Size()const{
+	return _index.size();
+}
+/**
+ * Bytes accessor
+ * @return the FootprintBytes of every key and value
+ */
+size_t LruCache::Bytes()const{
+	return _bytes;
+}
+size_t LruCache::GetCapacity()const{
+	return _capacity;
+}
+/**
+ * Changes the maximum number of entries, evicting the entries above it
+ * @param capacity the maximum entries, 0 for no limit
+ */
+void LruCache::SetCapacity(size_t capacity){
+	_capacity = capacity;
+	Evict(0, 0);
+}
+size_t LruCache::GetByteLimit()const{
+	return _byteLimit;
+}
+/**
+ * Changes the maximum bytes, evicting the entries above it
+ * @param byteLimit the maximum bytes, 0 for no limit
+ */
+void LruCache::SetByteLimit(size_t byteLimit){
+	_byteLimit = byteLimit;
+	Evict(0, 0);
+}
+const CacheStats& LruCache::Stats()const{
+	return _stats;
+}
+void LruCache::ResetStats(){
+	_stats = CacheStats();
+}
+/**
+ * Recency order accessor
+ * @return the keys, most recently used first
+ */
+const DoubleLinkedList& LruCache::Recency()const{
+	return _recency;
+}
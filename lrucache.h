@@ -0,0 +1,87 @@
+/*
+ * Title:		LRU Cache
+ * Purpose:		Declaration of a least recently used cache of Object keys and
+ * 				values. The recency order is a DoubleLinkedList of the keys,
+ * 				most recent first, and a hash index maps every key (by
+ * 				Object::Hash and Equals) to its node. Lookups, moves to the
+ * 				front, inserts and evictions from the tail work on the nodes
+ * 				directly, none of them walks the list.
+ *
+ * 				The cache owns its keys and values. It evicts the least
+ * 				recently used entries when it holds more than its capacity
+ * 				or more bytes (FootprintBytes of the keys and the values)
+ * 				than its byte limit.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include "object.h"
+#include "dlinkedlist.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+using std::string;
+
+/**
+ * What the lookups of a cache found
+ */
+struct CacheStats{
+	unsigned long long hits;		// Get found the key
+	unsigned long long misses;		// Get did not find the key
+	unsigned long long insertions;	// Put added a new entry
+	unsigned long long evictions;	// Entries dropped to respect the limits
+	CacheStats();
+	double HitRate()const;
+	string ToString()const;
+};
+
+class LruCache{
+	struct KeyHash{
+		size_t operator()(const Object* key)const;
+	};
+	struct KeyEquals{
+		bool operator()(const Object* lhs, const Object* rhs)const;
+	};
+	struct Entry{
+		DoubleLinkedList::Node* node;	// Node of the key in the recency list
+		Object* value;
+		size_t bytes;					// Footprint of the key and the value
+	};
+	typedef std::unordered_map<const Object*, Entry, KeyHash, KeyEquals> Index;
+
+	DoubleLinkedList _recency;		// Keys, most recently used first
+	Index _index;
+	size_t _capacity;				// Maximum entries, 0 for no limit
+	size_t _byteLimit;				// Maximum bytes, 0 for no limit
+	size_t _bytes;
+	CacheStats _stats;
+	void Evict(size_t entries, size_t bytes);
+	void Drop(Index::iterator entry);
+	LruCache(const LruCache&);
+	const LruCache& operator=(const LruCache&);
+public:
+	explicit LruCache(size_t capacity, size_t byteLimit = 0);
+	~LruCache();
+
+	bool Put(Object* key, Object* value);
+	Object* Get(const Object& key);
+	const Object* Peek(const Object& key)const;
+	bool Contains(const Object& key)const;
+	bool Erase(const Object& key);
+	void Clear();
+
+	size_t Size()const;
+	size_t Bytes()const;
+	size_t GetCapacity()const;
+	void SetCapacity(size_t capacity);
+	size_t GetByteLimit()const;
+	void SetByteLimit(size_t byteLimit);
+	const CacheStats& Stats()const;
+	void ResetStats();
+	const DoubleLinkedList& Recency()const;
+};
+
+#endif
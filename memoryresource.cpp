@@ -0,0 +1,320 @@
+/*
+ * Title:		Memory Resources
+ * Purpose:		Implementation of the default, monotonic and pool resources
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "memoryresource.h"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+/**
+ * Rounds a pointer up to a multiple of alignment
+ * @param pointer the pointer to round
+ * @param alignment a power of two
+ * @return the number of bytes to skip
+ */
+static size_t Padding(const char* pointer, size_t alignment){
+	uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+	return (alignment - address % alignment) % alignment;
+}
+
+/**
+ * Destructor
+ * Does not do anything, needs to be virtual for the subclasses
+ */
+MemoryResource::~MemoryResource(){
+
+}
+/**
+ * Allocates memory from the resource
+ * @param bytes the number of bytes
+ * @param alignment a power of two, the returned pointer is a multiple of it
+ * @return the memory, allocation failures throw std::bad_alloc
+ */
+void* MemoryResource::Allocate(size_t bytes, size_t alignment){
+	return DoAllocate(bytes, alignment);
+}
+/**
+ * Gives memory back to the resource that allocated it
+ * @param pointer the memory returned by Allocate
+ * @param bytes and alignment the same values given to Allocate
+ */
+void MemoryResource::Deallocate(void* pointer, size_t bytes, size_t alignment){
+	DoDeallocate(pointer, bytes, alignment);
+}
+/**
+ * Two resources are equal if memory allocated by one can be deallocated by
+ * the other, lists use it to decide whether nodes can move between them.
+ * @param other the resource to compare with
+ * @return true if they are interchangeable
+ */
+bool MemoryResource::IsEqual(const MemoryResource& other)const{
+	return this == &other || DoIsEqual(other);
+}
+/**
+ * By default a resource is only equal to itself
+ */
+bool MemoryResource::DoIsEqual(const MemoryResource& other)const{
+	return this == &other;
+}
+// Tagged memory from a resource starts TAG_BYTES after a TAG_ALIGN boundary,
+// the tag holding the resource is in between. The global heap returns
+// multiples of TAG_ALIGN, so the address alone tells the two apart.
+static const size_t TAG_ALIGN = 2 * MemoryResource::TAG_BYTES;
+static_assert(alignof(std::max_align_t) >= TAG_ALIGN, "The heap must return memory aligned to TAG_ALIGN to tell tagged memory apart");
+
+static bool IsTagged(const void* pointer){
+	return reinterpret_cast<uintptr_t>(pointer) % TAG_ALIGN == MemoryResource::TAG_BYTES;
+}
+static MemoryResource** Tag(const void* pointer){
+	return reinterpret_cast<MemoryResource**>(const_cast<char*>(static_cast<const char*>(pointer)) - MemoryResource::TAG_BYTES);
+}
+
+/**
+ * Allocates memory that DeallocateTagged frees without being told the
+ * resource. From the heap there is no tag. From any other resource the
+ * block is TAG_BYTES larger and the memory is aligned to TAG_BYTES only,
+ * enough for every Object but not for over-aligned types.
+ * @param bytes the number of bytes
+ * @param resource where the memory is allocated, nullptr for the heap
+ * @return the memory
+ */
+void* MemoryResource::AllocateTagged(size_t bytes, MemoryResource* resource){
+	if (resource == nullptr || resource->IsEqual(*Default())){
+		void* retVal = ::operator new(bytes);
+		assert(!IsTagged(retVal));
+		return retVal;
+	}
+	char* block = static_cast<char*>(resource->Allocate(TAG_BYTES + bytes, TAG_ALIGN));
+	*reinterpret_cast<MemoryResource**>(block) = resource;
+	return block + TAG_BYTES;
+}
+/**
+ * Gives memory allocated by AllocateTagged back to where it came from
+ * @param pointer the memory
+ * @param bytes the number of bytes given to AllocateTagged
+ */
+void MemoryResource::DeallocateTagged(void* pointer, size_t bytes){
+	if (!IsTagged(pointer)){
+		::operator delete(pointer);
+		return;
+	}
+	MemoryResource** tag = Tag(pointer);
+	(*tag)->Deallocate(tag, TAG_BYTES + bytes, TAG_ALIGN);
+}
+/**
+ * Resource of memory allocated by AllocateTagged
+ * @return the resource, Default() for the heap
+ */
+MemoryResource* MemoryResource::TaggedResource(const void* pointer){
+	return IsTagged(pointer) ? *Tag(pointer) : Default();
+}
+/**
+ * Bytes the tag adds to memory allocated by AllocateTagged
+ * @return TAG_BYTES for memory from a resource, 0 for the heap
+ */
+size_t MemoryResource::TagOverhead(const void* pointer){
+	return IsTagged(pointer) ? TAG_BYTES : 0;
+}
+/**
+ * The resource used when none is given
+ * @return the global new and delete resource
+ */
+MemoryResource* MemoryResource::Default(){
+	static NewDeleteResource instance;
+	return &instance;
+}
+
+void* NewDeleteResource::DoAllocate(size_t bytes, size_t alignment){
+	(void)alignment;	// Only checked by the assert
+	assert(alignment <= MAX_ALIGN);
+	return ::operator new(bytes);
+}
+void NewDeleteResource::DoDeallocate(void* pointer, size_t, size_t){
+	::operator delete(pointer);
+}
+/**
+ * Every new and delete resource uses the same global heap
+ */
+bool NewDeleteResource::DoIsEqual(const MemoryResource& other)const{
+	return dynamic_cast<const NewDeleteResource*>(&other) != nullptr;
+}
+
+/**
+ * Constructor
+ * No memory is reserved until the first allocation
+ * @param initialSize the bytes of the first chunk, each chunk doubles the
+ * size of the previous one
+ * @param upstream where the chunks come from
+ */
+MonotonicArena::MonotonicArena(size_t initialSize, MemoryResource* upstream) : _upstream(upstream),
+	_chunks(nullptr), _current(nullptr), _remaining(0), _nextSize(initialSize), _initialSize(initialSize),
+	_allocated(0){
+
+}
+/**
+ * Destructor
+ * Gives every chunk back to the upstream resource
+ */
+MonotonicArena::~MonotonicArena(){
+	Release();
+}
+/**
+ * Frees every allocation at once. Objects still living in the arena must
+ * not be used, or destroyed, afterwards.
+ */
+void MonotonicArena::Release(){
+	while (_chunks != nullptr){
+		Chunk* next = _chunks->next;
+		_upstream->Deallocate(_chunks, _chunks->size);
+		_chunks = next;
+	}
+	_current = nullptr;
+	_remaining = 0;
+	_nextSize = _initialSize;
+	_allocated = 0;
+}
+/**
+ * Allocated bytes accessor
+ * @return the bytes handed out since the last Release, without padding
+ */
+size_t MonotonicArena::BytesAllocated()const{
+	return _allocated;
+}
+/**
+ * Reserved bytes accessor
+ * @return the bytes obtained from the upstream resource
+ */
+size_t MonotonicArena::BytesReserved()const{
+	size_t retVal = 0;
+	for (Chunk* tmp = _chunks; tmp != nullptr; tmp = tmp->next){
+		retVal += tmp->size;
+	}
+	return retVal;
+}
+/**
+ * Bumps the current pointer, a new chunk is started when the current one
+ * cannot hold the request
+ */
+void* MonotonicArena::DoAllocate(size_t bytes, size_t alignment){
+	size_t padding = Padding(_current, alignment);
+	if (_current == nullptr || padding + bytes > _remaining){
+		Grow(bytes, alignment);
+		padding = Padding(_current, alignment);
+	}
+	char* retVal = _current + padding;
+	_current = retVal + bytes;
+	_remaining -= padding + bytes;
+	_allocated += bytes;
+	return retVal;
+}
+/**
+ * Does nothing, memory is only reclaimed by Release
+ */
+void MonotonicArena::DoDeallocate(void*, size_t, size_t){
+
+}
+/**
+ * Starts a new chunk big enough for the request, the rest of the current
+ * chunk is abandoned
+ */
+void MonotonicArena::Grow(size_t bytes, size_t alignment){
+	size_t size = sizeof(Chunk) + bytes + alignment;
+	if (size < _nextSize){
+		size = _nextSize;
+	}
+	Chunk* chunk = static_cast<Chunk*>(_upstream->Allocate(size));
+	chunk->next = _chunks;
+	chunk->size = size;
+	_chunks = chunk;
+	_current = reinterpret_cast<char*>(chunk + 1);
+	_remaining = size - sizeof(Chunk);
+	_nextSize = size * 2;
+}
+
+/**
+ * Constructor
+ * No memory is reserved until the first allocation
+ * @param upstream where the chunks and the large blocks come from
+ */
+PoolResource::PoolResource(MemoryResource* upstream) : _upstream(upstream), _chunks(nullptr),
+	_current(nullptr), _remaining(0), _reserved(0){
+	for (size_t i = 0; i < CLASSES; i++){
+		_free[i] = nullptr;
+	}
+}
+/**
+ * Destructor
+ * Gives every chunk back to the upstream resource
+ */
+PoolResource::~PoolResource(){
+	Release();
+}
+/**
+ * Frees every chunk at once. Large blocks were allocated upstream and must
+ * have been deallocated one by one.
+ */
+void PoolResource::Release(){
+	while (_chunks != nullptr){
+		Chunk* next = _chunks->next;
+		_upstream->Deallocate(_chunks, CHUNK);
+		_chunks = next;
+	}
+	for (size_t i = 0; i < CLASSES; i++){
+		_free[i] = nullptr;
+	}
+	_current = nullptr;
+	_remaining = 0;
+	_reserved = 0;
+}
+/**
+ * Reserved bytes accessor
+ * @return the bytes of the chunks obtained from the upstream resource
+ */
+size_t PoolResource::BytesReserved()const{
+	return _reserved;
+}
+/**
+ * Pops a block of the size class, or carves one from the current chunk
+ */
+void* PoolResource::DoAllocate(size_t bytes, size_t alignment){
+	if (bytes > MAX_BLOCK || alignment > GRANULE){
+		return _upstream->Allocate(bytes, alignment);
+	}
+	size_t index = bytes == 0 ? 0 : (bytes - 1) / GRANULE;
+	if (_free[index] != nullptr){
+		Block* retVal = _free[index];
+		_free[index] = retVal->next;
+		return retVal;
+	}
+	size_t size = (index + 1) * GRANULE;
+	if (size > _remaining){
+		// The rest of the current chunk is abandoned, less than MAX_BLOCK bytes
+		Chunk* chunk = static_cast<Chunk*>(_upstream->Allocate(CHUNK));
+		chunk->next = _chunks;
+		_chunks = chunk;
+		_reserved += CHUNK;
+		_current = reinterpret_cast<char*>(chunk) + GRANULE;
+		_remaining = CHUNK - GRANULE;
+	}
+	void* retVal = _current;
+	_current += size;
+	_remaining -= size;
+	return retVal;
+}
+/**
+ * Pushes the block on the free list of its size class
+ */
+void PoolResource::DoDeallocate(void* pointer, size_t bytes, size_t alignment){
+	if (bytes > MAX_BLOCK || alignment > GRANULE){
+		_upstream->Deallocate(pointer, bytes, alignment);
+		return;
+	}
+	size_t index = bytes == 0 ? 0 : (bytes - 1) / GRANULE;
+	Block* block = static_cast<Block*>(pointer);
+	block->next = _free[index];
+	_free[index] = block;
+}
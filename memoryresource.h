@@ -0,0 +1,121 @@
+/*
+ * Title:		Memory Resources
+ * Purpose:		Declaration of pluggable allocators for lists and elements, in
+ * 				the style of std::pmr::memory_resource but usable from C++14.
+ * 				MonotonicArena bump-allocates and frees everything at once,
+ * 				PoolResource recycles blocks of a few size classes. Neither is
+ * 				synchronized, a resource must be used by one thread at a time
+ * 				(do not combine them with a background Reclaimer).
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+
+#include <cstddef>
+
+class MemoryResource{
+public:
+	static const size_t MAX_ALIGN = alignof(std::max_align_t);
+
+	virtual ~MemoryResource();
+	void* Allocate(size_t bytes, size_t alignment = MAX_ALIGN);
+	void Deallocate(void* pointer, size_t bytes, size_t alignment = MAX_ALIGN);
+	bool IsEqual(const MemoryResource& other)const;
+
+	static MemoryResource* Default();
+
+	// Memory that knows where it came from, for objects and buffers freed
+	// without their resource at hand. Only memory from a resource other than
+	// Default() pays for a tag, heap memory is plain ::operator new.
+	static const size_t TAG_BYTES = sizeof(void*);
+	static void* AllocateTagged(size_t bytes, MemoryResource* resource);
+	static void DeallocateTagged(void* pointer, size_t bytes);
+	static MemoryResource* TaggedResource(const void* pointer);
+	static size_t TagOverhead(const void* pointer);
+protected:
+	virtual void* DoAllocate(size_t bytes, size_t alignment) = 0;
+	virtual void DoDeallocate(void* pointer, size_t bytes, size_t alignment) = 0;
+	virtual bool DoIsEqual(const MemoryResource& other)const;
+};
+
+/**
+ * Global operator new and delete, the resource returned by Default()
+ */
+class NewDeleteResource final : public MemoryResource{
+protected:
+	virtual void* DoAllocate(size_t bytes, size_t alignment);
+	virtual void DoDeallocate(void* pointer, size_t bytes, size_t alignment);
+	virtual bool DoIsEqual(const MemoryResource& other)const;
+};
+
+/**
+ * Hands out memory from chunks obtained from an upstream resource by
+ * bumping a pointer. Deallocate does nothing, the memory comes back when
+ * Release is called or the arena is destroyed.
+ */
+class MonotonicArena final : public MemoryResource{
+	struct Chunk{
+		Chunk* next;
+		size_t size;
+	};
+	MemoryResource* _upstream;
+	Chunk* _chunks;
+	char* _current;
+	size_t _remaining;
+	size_t _nextSize;
+	size_t _initialSize;
+	size_t _allocated;
+	MonotonicArena(const MonotonicArena&);
+	const MonotonicArena& operator=(const MonotonicArena&);
+	void Grow(size_t bytes, size_t alignment);
+protected:
+	virtual void* DoAllocate(size_t bytes, size_t alignment);
+	virtual void DoDeallocate(void* pointer, size_t bytes, size_t alignment);
+public:
+	explicit MonotonicArena(size_t initialSize = 4096, MemoryResource* upstream = MemoryResource::Default());
+	virtual ~MonotonicArena();
+
+	void Release();
+	size_t BytesAllocated()const;
+	size_t BytesReserved()const;
+};
+
+/**
+ * Keeps a free list per size class, multiples of GRANULE bytes up to
+ * MAX_BLOCK, and carves new blocks from chunks of the upstream resource.
+ * Larger or over-aligned requests go straight to the upstream resource.
+ */
+class PoolResource final : public MemoryResource{
+public:
+	static const size_t GRANULE = 16;
+	static const size_t MAX_BLOCK = 512;
+	static const size_t CHUNK = 64 * 1024;
+private:
+	static const size_t CLASSES = MAX_BLOCK / GRANULE;
+	struct Block{
+		Block* next;
+	};
+	struct Chunk{
+		Chunk* next;
+	};
+	MemoryResource* _upstream;
+	Block* _free[CLASSES];
+	Chunk* _chunks;
+	char* _current;
+	size_t _remaining;
+	size_t _reserved;
+	PoolResource(const PoolResource&);
+	const PoolResource& operator=(const PoolResource&);
+protected:
+	virtual void* DoAllocate(size_t bytes, size_t alignment);
+	virtual void DoDeallocate(void* pointer, size_t bytes, size_t alignment);
+public:
+	explicit PoolResource(MemoryResource* upstream = MemoryResource::Default());
+	virtual ~PoolResource();
+
+	void Release();
+	size_t BytesReserved()const;
+};
+
+#endif
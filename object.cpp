@@ -5,7 +5,9 @@
  * Date:		April 29, 2020
  */
 #include "object.h"
+#include "objectcounters.h"
 
+#include <functional>
 #include <string>
 #include <sstream>
 using std::string;
@@ -15,14 +17,21 @@ using std::stringstream;
  * Does not do anything
  */
 Object::Object(){
-
+	OBJECT_COUNTERS_CREATED(TYPE_OBJECT, 0);
+}
+/**
+ * Copy Constructor
+ * There is nothing to copy, it only exists so copies are counted
+ */
+Object::Object(const Object&){
+	OBJECT_COUNTERS_CREATED(TYPE_OBJECT, 0);
 }
 /**
  * Destructor
  * Does not do anything
  */
 Object::~Object(){
-
+	OBJECT_COUNTERS_DESTROYED(TYPE_OBJECT, 0);
 }
 /**
  * ToString
@@ -51,6 +60,15 @@ bool Object::Equals(const Object& rhs)const{
 		return false;
 	}
 }
+/**
+ * Hash code consistent with Equals, objects that are equal have the same
+ * hash. Sub-classes that override Equals must override this method too.
+ * At this level an object is only equal to itself, so the address is used.
+ * @return the hash of the object
+ */
+size_t Object::Hash()const{
+	return std::hash<const Object*>()(this);
+}
 /**
  * Creates a clone of the object.
  * In certain situations it is not possible to explicitly call the
@@ -61,3 +79,67 @@ bool Object::Equals(const Object& rhs)const{
 Object* Object::Clone()const{
 	return new Object();
 }
+/**
+ * Creates a clone of the object in the given memory resource.
+ * Sub-classes that override Clone() must override this method too.
+ * @param resource where the clone and the memory it owns are allocated
+ * @return a deep copy of the object, delete releases it to the resource
+ */
+Object* Object::Clone(MemoryResource* resource)const{
+	return new (resource) Object();
+}
+
+/**
+ * Memory footprint
+ * The number of bytes this object uses, including any buffer it owns.
+ * Sub-classes that own dynamic memory must override this method.
+ * @return the size of the object in bytes
+ */
+size_t Object::FootprintBytes()const{
+	return sizeof(Object);
+}
+/**
+ * Intrusive list hook
+ * Objects that can be linked into an IntrusiveList embed a ListHook and
+ * return it here. A plain object has no hook.
+ * @return the hook of the object, nullptr if it has none
+ */
+ListHook* Object::Hook(){
+	return nullptr;
+}
+
+/**
+ * Allocates an object from the global heap, the fast path of new. The
+ * object carries nothing but its own members.
+ * @param bytes the size of the object
+ * @return the memory for the object
+ */
+void* Object::operator new(size_t bytes){
+	return MemoryResource::AllocateTagged(bytes, nullptr);
+}
+/**
+ * Allocates an object from a memory resource, new (resource) Integer(5).
+ * A tag in front of the object remembers the resource for delete.
+ * @param bytes the size of the object
+ * @param resource where the object is allocated
+ * @return the memory for the object
+ */
+void* Object::operator new(size_t bytes, MemoryResource* resource){
+	return MemoryResource::AllocateTagged(bytes, resource);
+}
+/**
+ * Gives the memory of a deleted object back to where it came from
+ * @param pointer the object memory
+ * @param bytes the size of the object, the dynamic type's size
+ */
+void Object::operator delete(void* pointer, size_t bytes){
+	MemoryResource::DeallocateTagged(pointer, bytes);
+}
+/**
+ * Called when a constructor throws during new (resource). The size of the
+ * object is not known here and a pool needs it, so the block is left to
+ * the resource and comes back when the resource is released.
+ */
+void Object::operator delete(void*, MemoryResource*){
+
+}
@@ -7,17 +7,33 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include "memoryresource.h"
+
 #include <string>
 using std::string;
 
+class ListHook;
+
 class Object{
 
 public:
 	Object();
+	Object(const Object& other);
 	virtual ~Object();
 	virtual string ToString()const;
 	virtual bool Equals(const Object& rhs)const;
+	virtual size_t Hash()const;
 	virtual Object* Clone()const;
+	virtual Object* Clone(MemoryResource* resource)const;
+	virtual size_t FootprintBytes()const;
+	virtual ListHook* Hook();
+
+	// new (resource) Integer(5) allocates from a resource and tags the object
+	// with it so delete works on any object, objects from the heap have no tag.
+	static void* operator new(size_t bytes);
+	static void* operator new(size_t bytes, MemoryResource* resource);
+	static void operator delete(void* pointer, size_t bytes);
+	static void operator delete(void* pointer, MemoryResource* resource);
 };
 
 #endif
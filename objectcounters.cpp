@@ -0,0 +1,104 @@
+/*
+ * Title:		Object Counters
+ * Purpose:		Definition of the global counters of live objects and
+ * 				allocated bytes per type
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "objectcounters.h"
+
+#include <atomic>
+#include <string>
+#include <sstream>
+using std::string;
+using std::stringstream;
+
+namespace{
+	// Atomic because elements are created and destroyed from worker threads too
+	std::atomic<long long> live[ObjectCounters::TYPE_COUNT];
+	std::atomic<unsigned long long> created[ObjectCounters::TYPE_COUNT];
+	std::atomic<long long> liveBytes[ObjectCounters::TYPE_COUNT];
+	std::atomic<unsigned long long> allocatedBytes[ObjectCounters::TYPE_COUNT];
+}
+
+/**
+ * Records the construction of an object
+ * @param type the type of the object
+ * @param bytes the bytes allocated for it, including owned buffers
+ */
+void ObjectCounters::Created(Type type, size_t bytes){
+	live[type]++;
+	created[type]++;
+	liveBytes[type] += bytes;
+	allocatedBytes[type] += bytes;
+}
+/**
+ * Records the destruction of an object
+ * @param type the type of the object
+ * @param bytes the bytes that are being released, same as when created
+ */
+void ObjectCounters::Destroyed(Type type, size_t bytes){
+	live[type]--;
+	liveBytes[type] -= bytes;
+}
+/**
+ * Records that a live object replaced one of its owned buffers
+ * @param type the type of the object
+ * @param oldBytes the bytes of the object before the change
+ * @param newBytes the bytes of the object after the change
+ */
+void ObjectCounters::Reallocated(Type type, size_t oldBytes, size_t newBytes){
+	liveBytes[type] += static_cast<long long>(newBytes) - static_cast<long long>(oldBytes);
+	allocatedBytes[type] += newBytes;
+}
+/**
+ * Takes a copy of all the counters
+ * @return the counters at this moment
+ */
+ObjectCounters::Snapshot ObjectCounters::Get(){
+	Snapshot retVal;
+	for (size_t t = 0; t < TYPE_COUNT; t++){
+		retVal.live[t] = live[t];
+		retVal.created[t] = created[t];
+		retVal.liveBytes[t] = liveBytes[t];
+		retVal.allocatedBytes[t] = allocatedBytes[t];
+	}
+	return retVal;
+}
+/**
+ * Sets all the counters to zero. Objects alive at this moment will make
+ * the live counters negative when destroyed.
+ */
+void ObjectCounters::Reset(){
+	for (size_t t = 0; t < TYPE_COUNT; t++){
+		live[t] = 0;
+		created[t] = 0;
+		liveBytes[t] = 0;
+		allocatedBytes[t] = 0;
+	}
+}
+/**
+ * Name of a type, as used in the dump
+ * @param type the type
+ * @return the class name
+ */
+const char* ObjectCounters::TypeName(Type type){
+	switch (type){
+		case TYPE_OBJECT:	return "Object";
+		case TYPE_INTEGER:	return "Integer";
+		case TYPE_PERSON:	return "Person";
+		default:		return "Unknown";
+	}
+}
+/**
+ * Creates a string representation of the counters, one line per type
+ * @return a multi line string with the counters
+ */
+string ObjectCounters::Snapshot::ToString()const{
+	stringstream retVal;
+	for (size_t t = 0; t < TYPE_COUNT; t++){
+		retVal << TypeName(static_cast<Type>(t)) << ": " << live[t] << " live (" << liveBytes[t]
+			<< " bytes), " << created[t] << " created (" << allocatedBytes[t] << " bytes)\n";
+	}
+	return retVal.str();
+}
@@ -0,0 +1,50 @@
+/*
+ * Title:		Object Counters
+ * Purpose:		Declaration of the optional global counters of live objects
+ * 				and allocated bytes per type. The recording macros compile to
+ * 				nothing unless OBJECT_COUNTERS is defined.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef OBJECT_COUNTERS_H
+#define OBJECT_COUNTERS_H
+
+#include <cstddef>
+#include <string>
+using std::string;
+
+class ObjectCounters{
+public:
+	enum Type{
+		TYPE_OBJECT,		// Every Object, including the subclasses below and lists
+		TYPE_INTEGER,
+		TYPE_PERSON,
+		TYPE_COUNT
+	};
+	struct Snapshot{
+		long long live[TYPE_COUNT];
+		unsigned long long created[TYPE_COUNT];
+		long long liveBytes[TYPE_COUNT];
+		unsigned long long allocatedBytes[TYPE_COUNT];
+		string ToString()const;
+	};
+	static void Created(Type type, size_t bytes);
+	static void Destroyed(Type type, size_t bytes);
+	static void Reallocated(Type type, size_t oldBytes, size_t newBytes);
+	static Snapshot Get();
+	static void Reset();
+	static const char* TypeName(Type type);
+};
+
+#ifdef OBJECT_COUNTERS
+#define OBJECT_COUNTERS_CREATED(type, bytes) ObjectCounters::Created(ObjectCounters::type, (bytes))
+#define OBJECT_COUNTERS_DESTROYED(type, bytes) ObjectCounters::Destroyed(ObjectCounters::type, (bytes))
+#define OBJECT_COUNTERS_REALLOCATED(type, oldBytes, newBytes) \
+	ObjectCounters::Reallocated(ObjectCounters::type, (oldBytes), (newBytes))
+#else
+#define OBJECT_COUNTERS_CREATED(type, bytes) ((void)0)
+#define OBJECT_COUNTERS_DESTROYED(type, bytes) ((void)0)
+#define OBJECT_COUNTERS_REALLOCATED(type, oldBytes, newBytes) ((void)0)
+#endif
+
+#endif
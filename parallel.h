@@ -0,0 +1,64 @@
+/*
+ * Title:		Parallel Ranges
+ * Purpose:		Splits the positions [0, count) into contiguous ranges and runs
+ * 				a function on each range in its own thread. Used by the deep
+ * 				copies of the lists. Ranges smaller than PARALLEL_GRAIN are
+ * 				not worth a thread, short lists run in the calling thread.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+const size_t PARALLEL_GRAIN = 4096;		// Minimum positions per thread
+
+/**
+ * Number of ranges count positions are split in
+ * @param count the number of positions
+ * @param threads the threads requested, 0 for one per hardware thread
+ * @return at least 1, at most threads and one per PARALLEL_GRAIN positions
+ */
+inline size_t ParallelRanges(size_t count, size_t threads){
+	if (threads == 0){
+		threads = std::thread::hardware_concurrency();
+	}
+	size_t limit = (count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+	if (threads > limit){
+		threads = limit;
+	}
+	return threads == 0 ? 1 : threads;
+}
+/**
+ * First position of a range, the ranges differ in size by at most one
+ * @param count the number of positions
+ * @param ranges the number of ranges
+ * @param range the range, ranges gives the end of the last one
+ */
+inline size_t ParallelRangeStart(size_t count, size_t ranges, size_t range){
+	return count / ranges * range + (range < count % ranges ? range : count % ranges);
+}
+/**
+ * Runs function(range, first, last) for every range, the last range in the
+ * calling thread and the others in their own threads, and waits for all
+ * @param count the number of positions
+ * @param ranges the number of ranges, from ParallelRanges
+ * @param function called once per range
+ */
+template <class Function>
+void ParallelFor(size_t count, size_t ranges, Function function){
+	std::vector<std::thread> workers;
+	for (size_t range = 0; range + 1 < ranges; range++){
+		workers.push_back(std::thread(function, range, ParallelRangeStart(count, ranges, range),
+			ParallelRangeStart(count, ranges, range + 1)));
+	}
+	function(ranges - 1, ParallelRangeStart(count, ranges, ranges - 1), count);
+	for (std::thread& worker : workers){
+		worker.join();
+	}
+}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Title:		Hardware Performance Counters
+ * Purpose:		Implementation of the perf_event_open counters. Every event
+ * 				is a descriptor of its own, enabled and disabled around each
+ * 				region and read with the time it was enabled and running.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "perfcounters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace{
+	const char* const NAMES[PerfCounters::EVENTS] = {
+		"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses", "dtlb_misses"
+	};
+#ifdef __linux__
+	/**
+	 * Type and configuration of an event
+	 */
+	struct EventCode{
+		unsigned int type;
+		unsigned long long config;
+	};
+	/**
+	 * Configuration of a read miss of a cache
+	 * @param cache one of the PERF_COUNT_HW_CACHE_* caches
+	 */
+	unsigned long long ReadMisses(unsigned long long cache){
+		return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	}
+	const EventCode CODES[PerfCounters::EVENTS] = {
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+		{PERF_TYPE_HW_CACHE, ReadMisses(PERF_COUNT_HW_CACHE_L1D)},
+		{PERF_TYPE_HW_CACHE, ReadMisses(PERF_COUNT_HW_CACHE_LL)},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+		{PERF_TYPE_HW_CACHE, ReadMisses(PERF_COUNT_HW_CACHE_DTLB)},
+	};
+	/**
+	 * Opens a disabled counter of the calling thread on any processor
+	 * @return the descriptor, -1 with errno set if the event is not offered
+	 */
+	int Open(const EventCode& code){
+		perf_event_attr attributes;
+		memset(&attributes, 0, sizeof(attributes));
+		attributes.size = sizeof(attributes);
+		attributes.type = code.type;
+		attributes.config = code.config;
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+	}
+#endif
+}
+
+/**
+ * Constructor
+ * Opens every event, the ones that fail are left out
+ */
+PerfCounters::PerfCounters() : _running(false){
+	for (size_t i = 0; i < EVENTS; i++){
+		_counts[i] = 0;
+#ifdef __linux__
+		_descriptors[i] = Open(CODES[i]);
+		if (_descriptors[i] < 0 && _error.empty()){
+			_error = string(NAMES[i]) + ": " + strerror(errno);
+		}
+#else
+		_descriptors[i] = -1;
+#endif
+	}
+#ifndef __linux__
+	_error = "perf_event_open is only available on Linux";
+#endif
+}
+/**
+ * Destructor
+ * Closes the events
+ */
+PerfCounters::~PerfCounters(){
+#ifdef __linux__
+	for (size_t i = 0; i < EVENTS; i++){
+		if (_descriptors[i] >= 0){
+			close(_descriptors[i]);
+		}
+	}
+#endif
+}
+/**
+ * Checks if any event can be counted
+ * @return false if no event opened, Error tells why
+ */
+bool PerfCounters::Available()const{
+	for (size_t i = 0; i < EVENTS; i++){
+		if (_descriptors[i] >= 0){
+			return true;
+		}
+	}
+	return false;
+}
+bool PerfCounters::Available(Event event)const{
+	return _descriptors[event] >= 0;
+}
+/**
+ * Error accessor
+ * @return why the first event that failed did not open, empty if all opened
+ */
+const string& PerfCounters::Error()const{
+	return _error;
+}
+/**
+ * Starts counting a region, does nothing if it is already counting
+ */
+void PerfCounters::Start(){
+	if (_running){
+		return;
+	}
+	_running = true;
+#ifdef __linux__
+	for (size_t i = 0; i < EVENTS; i++){
+		if (_descriptors[i] >= 0){
+			ioctl(_descriptors[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(_descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+}
+/**
+ * Stops counting a region and adds its counts, does nothing if it is not
+ * counting
+ */
+void PerfCounters::Stop(){
+	if (!_running){
+		return;
+	}
+	_running = false;
+#ifdef __linux__
+	for (size_t i = 0; i < EVENTS; i++){
+		if (_descriptors[i] >= 0){
+			ioctl(_descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+		}
+	}
+	for (size_t i = 0; i < EVENTS; i++){
+		// Value, time enabled and time running
+		unsigned long long values[3];
+		if (_descriptors[i] < 0 || read(_descriptors[i], values, sizeof(values)) != sizeof(values)){
+			continue;
+		}
+		if (values[2] != 0){
+			_counts[i] += static_cast<double>(values[0]) * values[1] / values[2];
+		}
+	}
+#endif
+}
+/**
+ * Sets the counts to zero
+ */
+void PerfCounters::Reset(){
+	for (size_t i = 0; i < EVENTS; i++){
+		_counts[i] = 0;
+	}
+}
+bool PerfCounters::Running()const{
+	return _running;
+}
+/**
+ * Count accessor
+ * @param event the event
+ * @return the count of the regions since Reset, 0 if the event is not available
+ */
+double PerfCounters::Count(Event event)const{
+	return _counts[event];
+}
+/**
+ * Name accessor
+ * @return the name of an event, used in the benchmark output
+ */
+const char* PerfCounters::Name(Event event){
+	return NAMES[event];
+}
@@ -0,0 +1,51 @@
+/*
+ * Title:		Hardware Performance Counters
+ * Purpose:		Declaration of a set of Linux perf_event_open counters of the
+ * 				calling thread: cycles, instructions, L1 data cache misses,
+ * 				last level cache misses, branch misses and data TLB misses.
+ * 				Start and Stop bracket a measured region, the counts of every
+ * 				region are added until Reset. Only user space is counted so
+ * 				the default perf_event_paranoid setting allows it.
+ *
+ * 				Every event is opened on its own. An event the processor or
+ * 				the kernel does not offer (a virtual machine, a container
+ * 				without the perf_event_open system call, another operating
+ * 				system) is left out, and when none opens the counters are not
+ * 				available and Start and Stop do nothing. Counts of events the
+ * 				kernel had to multiplex are scaled to the whole region.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstddef>
+#include <string>
+using std::string;
+
+class PerfCounters{
+public:
+	enum Event {CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, EVENTS};
+private:
+	int _descriptors[EVENTS];		// -1 for the events that did not open
+	double _counts[EVENTS];			// Counts of the regions since Reset
+	bool _running;
+	string _error;					// Why the first event that failed did not open
+	PerfCounters(const PerfCounters&);
+	const PerfCounters& operator=(const PerfCounters&);
+public:
+	PerfCounters();
+	~PerfCounters();
+
+	bool Available()const;
+	bool Available(Event event)const;
+	const string& Error()const;
+	void Start();
+	void Stop();
+	void Reset();
+	bool Running()const;
+	double Count(Event event)const;
+	static const char* Name(Event event);
+};
+
+#endif
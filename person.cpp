@@ -5,6 +5,7 @@
  * Date:		April 29, 2020
  */
 #include "person.h"
+#include "objectcounters.h"
 
 #include <cstring>
 #include <string>
@@ -16,10 +17,11 @@ using std::stringstream;
  * Creates a person using the values of the parameters.
  * @param name the name of the person as a string
  * @param age the age of the person
+ * @param resource where the name is allocated
  */
-Person::Person(const string& name, size_t age) : _age(age){
-	_name = new char[name.length() + 1];
-	strcpy(_name, name.c_str());
+Person::Person(const string& name, size_t age, MemoryResource* resource) : _age(age){
+	SetName(name.c_str(), name.length(), resource);
+	OBJECT_COUNTERS_CREATED(TYPE_PERSON, FootprintBytes());
 }
 /**
  * Copy constructor
@@ -27,9 +29,19 @@ Person::Person(const string& name, size_t age) : _age(age){
  * for the name, so it is required to have a copy constructor
  * @param person the original person being copied
  */
-Person::Person(const Person& person) : _age(person._age){
-	_name = new char[strlen(person._name) + 1];
-	strcpy(_name, person._name);
+Person::Person(const Person& person) : Object(person), _age(person._age){
+	SetName(person._name, strlen(person._name), nullptr);
+	OBJECT_COUNTERS_CREATED(TYPE_PERSON, FootprintBytes());
+}
+/**
+ * Copy constructor with a memory resource
+ * Creates a deep copy of the person whose name is allocated in resource
+ * @param person the original person being copied
+ * @param resource where the name of the copy is allocated
+ */
+Person::Person(const Person& person, MemoryResource* resource) : Object(person), _age(person._age){
+	SetName(person._name, strlen(person._name), resource);
+	OBJECT_COUNTERS_CREATED(TYPE_PERSON, FootprintBytes());
 }
 /**
  * Copy Assignment Operator
@@ -39,10 +51,15 @@ Person::Person(const Person& person) : _age(person._age){
  */
 const Person& Person::operator=(const Person& rhs){
 	if (strlen(_name) != strlen(rhs._name)){
-		delete[] _name;
-		_name = new char[strlen(rhs._name) + 1];
+		OBJECT_COUNTERS_REALLOCATED(TYPE_PERSON, FootprintBytes(),
+			sizeof(Person) + strlen(rhs._name) + 1 + MemoryResource::TagOverhead(_name));
+		// The new name goes where the old one was
+		MemoryResource* resource = MemoryResource::TaggedResource(_name);
+		MemoryResource::DeallocateTagged(_name, strlen(_name) + 1);
+		SetName(rhs._name, strlen(rhs._name), resource);
+	}else{
+		strcpy(_name, rhs._name);
 	}
-	strcpy(_name, rhs._name);
 	return *this;
 }
 /**
@@ -50,7 +67,8 @@ const Person& Person::operator=(const Person& rhs){
  * Releases the memory used by the name
  */
 Person::~Person(){
-	delete[] _name;
+	OBJECT_COUNTERS_DESTROYED(TYPE_PERSON, FootprintBytes());
+	MemoryResource::DeallocateTagged(_name, strlen(_name) + 1);
 }
 /**
  * Creates a string representation of a person.
@@ -82,6 +100,13 @@ bool Person::Equals(const Object& rhs)const{
 	return strcmp(rhsPtr->_name, _name) == 0 && rhsPtr->_age == _age;
 
 }
+/**
+ * Hash code consistent with Equals, combines the name and the age
+ * @return the hash of the person
+ */
+size_t Person::Hash()const{
+	return HashOf(_name, _age);
+}
 /**
  * Explicitly creates a deep copy of this
  * @return a new copy of this
@@ -89,9 +114,67 @@ bool Person::Equals(const Object& rhs)const{
 Object* Person::Clone()const{
 	return new Person(*this);
 }
+/**
+ * Creates a deep copy of this in a memory resource, the name included
+ * @param resource where the copy and its name are allocated
+ * @return a new copy of this
+ */
+Object* Person::Clone(MemoryResource* resource)const{
+	return new (resource) Person(*this, resource);
+}
 /**
  * Increases the age of the person by 1
  */
 void Person::Birthday(){
 	_age++;
 }
+/**
+ * Name accessor
+ * @return the name of the person, owned by the person
+ */
+const char* Person::GetName()const{
+	return _name;
+}
+/**
+ * Age accessor
+ * @return the age of the person
+ */
+size_t Person::GetAge()const{
+	return _age;
+}
+
+/**
+ * Memory footprint
+ * Includes the dynamically allocated name buffer and its resource tag
+ * @return the size of the person plus its name in bytes
+ */
+size_t Person::FootprintBytes()const{
+	return sizeof(Person) + strlen(_name) + 1 + MemoryResource::TagOverhead(_name);
+}
+/**
+ * Allocates the name buffer and copies the name into it. The buffer is
+ * tagged with its resource, the person does not keep it.
+ * @param name the characters of the name
+ * @param length the number of characters, without the terminator
+ * @param resource where the name is allocated, nullptr for the heap
+ */
+void Person::SetName(const char* name, size_t length, MemoryResource* resource){
+	_name = static_cast<char*>(MemoryResource::AllocateTagged(length + 1, resource));
+	memcpy(_name, name, length);
+	_name[length] = '\0';
+}
+/**
+ * Hash of a person with a name and an age, for the lists that store
+ * persons without a Person object. Hash uses it, so equal persons hash the
+ * same however they are stored.
+ * @param name the name, NUL terminated
+ * @param age the age
+ * @return the hash Hash returns for that person
+ */
+size_t Person::HashOf(const char* name, size_t age){
+	size_t retVal = 0;
+	for (const char* character = name; *character != '\0'; character++){
+		retVal = retVal * 31 + static_cast<unsigned char>(*character);
+	}
+	return retVal * 31 + age;
+}
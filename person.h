@@ -16,15 +16,23 @@ using std::string;
 class Person : public Object{
 		char* _name;
 		size_t _age;
+		void SetName(const char* name, size_t length, MemoryResource* resource);
 	public:
-		Person(const string& name, size_t age);
+		Person(const string& name, size_t age, MemoryResource* resource = MemoryResource::Default());
 		Person(const Person& person);
+		Person(const Person& person, MemoryResource* resource);
 		const Person& operator=(const Person& rhs);
 		virtual ~Person();
 		virtual string ToString()const;
 		virtual bool Equals(const Object& rhs)const;
+		virtual size_t Hash()const;
 		virtual Object* Clone()const;
+		virtual Object* Clone(MemoryResource* resource)const;
+		virtual size_t FootprintBytes()const;
 		void Birthday();
+		const char* GetName()const;
+		size_t GetAge()const;
+		static size_t HashOf(const char* name, size_t age);
 };
 
 #endif /* end of include guard: PERSON */
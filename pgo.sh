@@ -0,0 +1,30 @@
+#!/bin/sh
+# Two stage profile guided optimization build.
+#   1. Builds instrumented binaries (LIST_PGO=GENERATE)
+#   2. Trains them by running the benchmark workloads and the unit tests
+#   3. Rebuilds in the same directory with the profiles (LIST_PGO=USE)
+# Usage: ./pgo.sh [build directory], extra cmake arguments in CMAKE_ARGS
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR=${1:-"$SOURCE_DIR/cmake-build-pgo"}
+PROFILE_DIR="$BUILD_DIR/pgo-profiles"
+
+rm -rf "$PROFILE_DIR"
+mkdir -p "$PROFILE_DIR"
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DLIST_PGO=GENERATE \
+	-DLIST_PGO_DIR="$PROFILE_DIR" $CMAKE_ARGS
+cmake --build "$BUILD_DIR"
+
+"$BUILD_DIR/list_benchmark" > /dev/null
+"$BUILD_DIR/list" > /dev/null
+
+# Clang writes raw profiles that have to be merged, GCC reads its own directly
+if ls "$PROFILE_DIR"/*.profraw > /dev/null 2>&1; then
+	llvm-profdata merge -output="$PROFILE_DIR/list.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR" -DLIST_PGO=USE
+cmake --build "$BUILD_DIR"
+echo "Profile guided build ready in $BUILD_DIR"
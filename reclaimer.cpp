@@ -0,0 +1,151 @@
+/*
+ * Title:		Reclaimer
+ * Purpose:		Implementation of the deferred destruction queue. Garbage is
+ * 				released in batches of at most BATCH elements with the lock
+ * 				released, so Defer never waits for a large list to be freed.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "reclaimer.h"
+
+/**
+ * Destructor
+ * Does not do anything, needs to be virtual for the subclasses
+ */
+Reclaimer::Garbage::~Garbage(){
+
+}
+/**
+ * Constructor
+ * @param background true to release the garbage in a background thread,
+ * false to release it only when the owner calls Reclaim or Wait
+ */
+Reclaimer::Reclaimer(bool background) : _released(0), _busy(0), _stopping(false){
+	if (background){
+		_thread = std::thread(&Reclaimer::Run, this);
+	}
+}
+/**
+ * Destructor
+ * Releases everything that is still pending and stops the thread
+ */
+Reclaimer::~Reclaimer(){
+	Wait();
+	if (_thread.joinable()){
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_work.notify_one();
+		_thread.join();
+	}
+}
+/**
+ * Queues storage detached from a list. The reclaimer owns it from now on.
+ * @param garbage the storage to release
+ */
+void Reclaimer::Defer(Garbage* garbage){
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push_back(garbage);
+	}
+	_work.notify_one();
+}
+/**
+ * Releases a bounded number of elements in the calling thread, for owners
+ * that spread the cost over their own loop instead of using a thread.
+ * @param budget the maximum number of elements to delete
+ * @return the number of elements deleted
+ */
+size_t Reclaimer::Reclaim(size_t budget){
+	std::unique_lock<std::mutex> lock(_mutex);
+	size_t retVal = 0;
+	while (retVal < budget && !_queue.empty()){
+		retVal += ReleaseFront(budget - retVal, lock);
+	}
+	return retVal;
+}
+/**
+ * Blocks until all the deferred garbage has been released, including the
+ * garbage other threads are releasing with Reclaim. Without a background
+ * thread the queued garbage is released in the calling thread.
+ * Call it at shutdown, before the elements' types go away.
+ */
+void Reclaimer::Wait(){
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (!_thread.joinable()){
+		while (!_queue.empty()){
+			ReleaseFront(BATCH, lock);
+		}
+	}
+	_idle.wait(lock, [this]{ return _queue.empty() && _busy == 0; });
+}
+/**
+ * Pending accessor
+ * @return the number of detached storages not completely released
+ */
+size_t Reclaimer::Pending()const{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _queue.size() + _busy;
+}
+/**
+ * Released accessor
+ * @return the total number of elements deleted so far
+ */
+size_t Reclaimer::Released()const{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _released;
+}
+/**
+ * Background accessor
+ * @return true if a background thread releases the garbage
+ */
+bool Reclaimer::IsBackground()const{
+	return _thread.joinable();
+}
+/**
+ * Background thread, releases batches until asked to stop
+ */
+void Reclaimer::Run(){
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true){
+		_work.wait(lock, [this]{ return _stopping || !_queue.empty(); });
+		if (_queue.empty()){
+			return;
+		}
+		ReleaseFront(BATCH, lock);
+	}
+}
+/**
+ * Releases up to budget elements of the first garbage in the queue with
+ * the lock released. The garbage is taken out of the queue while it is
+ * being released so no other thread works on it at the same time. Garbage
+ * put back wakes the thread, the last release to finish with the queue
+ * empty wakes Wait.
+ * @param budget the maximum number of elements to delete
+ * @param lock the held lock of the queue, held again on return
+ * @return the number of elements deleted
+ */
+size_t Reclaimer::ReleaseFront(size_t budget, std::unique_lock<std::mutex>& lock){
+	Garbage* garbage = _queue.front();
+	_queue.pop_front();
+	_busy++;
+	lock.unlock();
+	size_t retVal = garbage->Release(budget);
+	bool done = garbage->Done();
+	if (done){
+		delete garbage;
+	}
+	lock.lock();
+	_busy--;
+	if (!done){
+		// The thread may have found the queue empty meanwhile
+		_queue.push_front(garbage);
+		_work.notify_one();
+	}
+	_released += retVal;
+	if (_queue.empty() && _busy == 0){
+		_idle.notify_all();
+	}
+	return retVal;
+}
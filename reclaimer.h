@@ -0,0 +1,59 @@
+/*
+ * Title:		Reclaimer
+ * Purpose:		Declaration of the deferred destruction queue. Lists that have
+ * 				a reclaimer hand their storage to it on Clear and destruction,
+ * 				which then takes constant time; the elements are deleted later
+ * 				by a background thread or in bounded increments by the owner.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef RECLAIMER_H
+#define RECLAIMER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class Reclaimer{
+public:
+	/**
+	 * Storage detached from a list, it knows how to release its elements
+	 * a few at a time.
+	 */
+	class Garbage{
+	public:
+		virtual ~Garbage();
+		// Deletes up to budget elements, returns how many were deleted
+		virtual size_t Release(size_t budget) = 0;
+		virtual bool Done()const = 0;
+	};
+	// Elements the background thread releases between checks of the queue
+	static const size_t BATCH = 4096;
+private:
+	mutable std::mutex _mutex;
+	std::condition_variable _work;
+	std::condition_variable _idle;
+	std::deque<Garbage*> _queue;
+	size_t _released;
+	size_t _busy;		// Garbage being released outside the lock, by the thread or Reclaim
+	bool _stopping;
+	std::thread _thread;
+	Reclaimer(const Reclaimer&);
+	const Reclaimer& operator=(const Reclaimer&);
+	void Run();
+	size_t ReleaseFront(size_t budget, std::unique_lock<std::mutex>& lock);
+public:
+	explicit Reclaimer(bool background = true);
+	~Reclaimer();
+
+	void Defer(Garbage* garbage);
+	size_t Reclaim(size_t budget);
+	void Wait();
+	size_t Pending()const;
+	size_t Released()const;
+	bool IsBackground()const;
+};
+
+#endif
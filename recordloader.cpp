@@ -0,0 +1,245 @@
+/*
+ * Title:		Record Loader
+ * Purpose:		Implementation of the streaming record loader. Numbers are
+ * 				parsed by hand, std::from_chars is C++17 and the streams pay
+ * 				for locales and virtual calls on every character.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "recordloader.h"
+#include "integer.h"
+#include "person.h"
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+using std::stringstream;
+
+/**
+ * Default Constructor
+ * Starts with every counter in zero
+ */
+LoadReport::LoadReport() : records(0), persons(0), integers(0), rejected(0), bytes(0), seconds(0), failed(false){
+
+}
+/**
+ * Throughput of the load
+ * @return the records inserted per second
+ */
+double LoadReport::RecordsPerSecond()const{
+	return seconds > 0 ? records / seconds : 0;
+}
+/**
+ * Creates a string representation of the report in JSON format
+ * @return a string with the counters and the throughput
+ */
+string LoadReport::ToString()const{
+	stringstream retVal;
+	retVal << "{records: " << records << ", persons: " << persons << ", integers: " << integers
+		<< ", rejected: " << rejected << ", bytes: " << bytes << ", seconds: " << seconds
+		<< ", recordsPerSecond: " << RecordsPerSecond() << (failed ? ", failed: true" : "") << "}";
+	return retVal.str();
+}
+
+/**
+ * Parses an unsigned decimal number that spans a whole token
+ * @param begin and end the token
+ * @param value where the number is written
+ * @return false if the token is not a number or does not fit
+ */
+static bool ParseUnsigned(const char* begin, const char* end, unsigned long long& value){
+	if (begin == end){
+		return false;
+	}
+	value = 0;
+	for (const char* character = begin; character != end; character++){
+		unsigned digit = static_cast<unsigned>(*character - '0');
+		if (digit > 9 || value > (ULLONG_MAX - digit) / 10){
+			return false;
+		}
+		value = value * 10 + digit;
+	}
+	return true;
+}
+/**
+ * Parses a decimal int with an optional minus sign that spans a whole token
+ * @param begin and end the token
+ * @param value where the number is written
+ * @return false if the token is not a number or does not fit an int
+ */
+static bool ParseInt(const char* begin, const char* end, int& value){
+	bool negative = begin != end && *begin == '-';
+	unsigned long long magnitude = 0;
+	if (!ParseUnsigned(begin + negative, end, magnitude)
+			|| magnitude > static_cast<unsigned long long>(INT_MAX) + negative){
+		return false;
+	}
+	value = negative ? static_cast<int>(-static_cast<long long>(magnitude)) : static_cast<int>(magnitude);
+	return true;
+}
+static bool IsSpace(char character){
+	return character == ' ' || character == '\t' || character == '\r';
+}
+
+/**
+ * Constructor
+ * @param resource where the elements are allocated
+ * @param chunk the bytes read from the input at a time
+ * @param batch the records parsed before they are inserted
+ */
+RecordLoader::RecordLoader(MemoryResource* resource, size_t chunk, size_t batch) : _resource(resource),
+	_chunk(chunk > 0 ? chunk : 1), _batch(batch > 0 ? batch : 1){
+
+}
+/**
+ * Loads every record of a stream into a list, in order. Records whose
+ * position is invalid when they are inserted are deleted and reported as
+ * rejected, like malformed lines.
+ * @param input the records, one per line
+ * @param list where the records are inserted
+ * @return what was loaded and how fast
+ */
+LoadReport RecordLoader::Load(istream& input, List& list){
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	LoadReport retVal;
+	vector<char>& buffer = _buffer;
+	if (buffer.size() < _chunk){
+		buffer.resize(_chunk);
+	}
+	size_t carried = 0;		// Bytes of an incomplete line kept from the last chunk
+	bool more = true;
+	while (more){
+		if (carried == buffer.size()){
+			// A line longer than the chunk
+			buffer.resize(buffer.size() * 2);
+		}
+		input.read(buffer.data() + carried, buffer.size() - carried);
+		size_t read = static_cast<size_t>(input.gcount());
+		retVal.bytes += read;
+		more = static_cast<bool>(input);
+		const char* data = buffer.data();
+		const char* end = data + carried + read;
+		const char* line = data;
+		const char* newline = nullptr;
+		while ((newline = static_cast<const char*>(memchr(line, '\n', end - line))) != nullptr){
+			ParseLine(line, newline, retVal);
+			line = newline + 1;
+			if (_pending.size() >= _batch){
+				Flush(list, retVal);
+			}
+		}
+		carried = end - line;
+		if (!more && carried > 0){
+			ParseLine(line, end, retVal);
+		}
+		memmove(buffer.data(), line, carried);
+	}
+	Flush(list, retVal);
+	retVal.failed = input.bad();
+	retVal.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return retVal;
+}
+/**
+ * Loads every record of a file into a list
+ * @param path the file with the records
+ * @param list where the records are inserted
+ * @return what was loaded and how fast, failed if the file cannot be read
+ */
+LoadReport RecordLoader::LoadFile(const string& path, List& list){
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if (!file){
+		LoadReport retVal;
+		retVal.failed = true;
+		return retVal;
+	}
+	return Load(file, list);
+}
+/**
+ * Parses one line into a pending element. Blank lines are skipped.
+ * @param begin and end the line without its newline
+ * @param report counts the malformed lines
+ * @return true if the line held a record
+ */
+bool RecordLoader::ParseLine(const char* begin, const char* end, LoadReport& report){
+	const size_t MAX_TOKENS = 3;
+	const char* tokens[MAX_TOKENS][2];
+	size_t count = 0;
+	const char* character = begin;
+	while (true){
+		while (character != end && IsSpace(*character)){
+			character++;
+		}
+		if (character == end){
+			break;
+		}
+		if (count == MAX_TOKENS){
+			report.rejected++;
+			return false;
+		}
+		tokens[count][0] = character;
+		while (character != end && !IsSpace(*character)){
+			character++;
+		}
+		tokens[count++][1] = character;
+	}
+	if (count == 0){
+		return false;
+	}
+
+	unsigned long long position = 0, age = 0;
+	int number = 0;
+	if (count == 2 && ParseInt(tokens[0][0], tokens[0][1], number)
+			&& ParseUnsigned(tokens[1][0], tokens[1][1], position)){
+		Object* element = _resource == MemoryResource::Default() ? new Integer(number) : new (_resource) Integer(number);
+		_pending.push_back({element, static_cast<size_t>(position), false});
+		return true;
+	}
+	if (count == 3 && ParseUnsigned(tokens[1][0], tokens[1][1], age)
+			&& ParseUnsigned(tokens[2][0], tokens[2][1], position)){
+		_name.assign(tokens[0][0], tokens[0][1] - tokens[0][0]);
+		Object* element = _resource == MemoryResource::Default() ? new Person(_name, age)
+			: new (_resource) Person(_name, age, _resource);
+		_pending.push_back({element, static_cast<size_t>(position), true});
+		return true;
+	}
+	report.rejected++;
+	return false;
+}
+/**
+ * Inserts the pending elements in order. A run of records with consecutive
+ * positions is inserted with one InsertRange call, it has the same result
+ * as inserting them one by one.
+ * @param list where the elements are inserted
+ * @param report counts the inserted and rejected records
+ */
+void RecordLoader::Flush(List& list, LoadReport& report){
+	size_t first = 0;
+	while (first < _pending.size()){
+		size_t last = first + 1;
+		while (last < _pending.size() && _pending[last].position == _pending[last - 1].position + 1){
+			last++;
+		}
+		_run.clear();
+		for (size_t i = first; i < last; i++){
+			_run.push_back(_pending[i].element);
+		}
+		size_t inserted = list.InsertRange(_run.data(), _run.size(), _pending[first].position);
+		for (size_t i = first; i < last; i++){
+			if (i - first < inserted){
+				report.records++;
+				if (_pending[i].person){
+					report.persons++;
+				}else{
+					report.integers++;
+				}
+			}else{
+				delete _pending[i].element;
+				report.rejected++;
+			}
+		}
+		first = last;
+	}
+	_pending.clear();
+}
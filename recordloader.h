@@ -0,0 +1,71 @@
+/*
+ * Title:		Record Loader
+ * Purpose:		Declaration of a streaming loader for the text record format
+ * 				of the tests, one record per line:
+ *
+ * 				name age position		a Person
+ * 				number position			an Integer
+ *
+ * 				The input is read in large chunks and parsed in place without
+ * 				streams or locales. Records are inserted in batches, runs of
+ * 				consecutive positions go through List::InsertRange.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef RECORD_LOADER_H
+#define RECORD_LOADER_H
+
+#include "list.h"
+#include "memoryresource.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+using std::istream;
+using std::string;
+using std::vector;
+
+/**
+ * What a load did
+ */
+struct LoadReport{
+	size_t records;		// Records inserted
+	size_t persons;
+	size_t integers;
+	size_t rejected;	// Malformed lines and records whose position was invalid
+	size_t bytes;		// Bytes read
+	double seconds;
+	bool failed;		// The input could not be opened or read
+	LoadReport();
+	double RecordsPerSecond()const;
+	string ToString()const;
+};
+
+class RecordLoader{
+public:
+	static const size_t CHUNK = 1 << 20;	// Bytes read at a time
+	static const size_t BATCH = 4096;		// Records parsed before inserting
+private:
+	struct Pending{
+		Object* element;
+		size_t position;
+		bool person;
+	};
+	MemoryResource* _resource;
+	size_t _chunk;
+	size_t _batch;
+	vector<char> _buffer;		// Kept between loads
+	vector<Pending> _pending;
+	vector<Object*> _run;
+	string _name;
+	bool ParseLine(const char* begin, const char* end, LoadReport& report);
+	void Flush(List& list, LoadReport& report);
+public:
+	explicit RecordLoader(MemoryResource* resource = MemoryResource::Default(), size_t chunk = CHUNK, size_t batch = BATCH);
+
+	LoadReport Load(istream& input, List& list);
+	LoadReport LoadFile(const string& path, List& list);
+};
+
+#endif
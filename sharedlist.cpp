@@ -0,0 +1,541 @@
+/*
+ * Title:		Shared List
+ * Purpose:		Implementation of the list in a POSIX shared memory segment.
+ * 				Offset 0 is the header, so 0 never names a record and stands
+ * 				for no record in the links. Removed records go to a free list
+ * 				linked through their next offsets.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#include "sharedlist.h"
+#include "integer.h"
+#include "person.h"
+
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Maps the pages of the segment up front where it is supported, the first
+// records written do not fault one page at a time
+#ifdef MAP_POPULATE
+const int SHARED_MAP_FLAGS = MAP_SHARED | MAP_POPULATE;
+#else
+const int SHARED_MAP_FLAGS = MAP_SHARED;
+#endif
+
+/**
+ * Start of the segment, every field is written under the mutex
+ */
+struct SharedList::Header{
+	uint32_t magic;			// MAGIC once the segment is initialized
+	uint32_t layout;
+	uint64_t capacity;		// Records in the segment
+	uint64_t used;			// Records handed out at least once
+	uint64_t free;			// Offset of the first free record, 0 for none
+	uint64_t head;
+	uint64_t tail;
+	uint64_t size;
+	uint64_t version;
+	pthread_mutex_t mutex;	// Process shared, robust and recursive
+};
+
+// The records start at the first cache line after the header
+const size_t SharedList::RECORDS = (sizeof(SharedList::Header) + 63) / 64 * 64;
+
+namespace{
+	/**
+	 * Encodes an Integer, a Person or the record of a SharedElement
+	 * @param element the element to encode
+	 * @param record where the element is encoded, the links are not touched
+	 * @return false for other objects and names that do not fit the record
+	 */
+	bool Encode(const Object& element, SharedRecord& record){
+		const Integer* integer = dynamic_cast<const Integer*>(&element);
+		if (integer != nullptr){
+			record.type = SharedRecord::INTEGER_RECORD;
+			record.value = integer->GetValue();
+			return true;
+		}
+		const Person* person = dynamic_cast<const Person*>(&element);
+		if (person != nullptr){
+			size_t length = strlen(person->GetName());
+			if (length >= SharedRecord::NAME_CAPACITY){
+				return false;
+			}
+			record.type = SharedRecord::PERSON_RECORD;
+			record.age = person->GetAge();
+			memcpy(record.name, person->GetName(), length + 1);
+			return true;
+		}
+		const SharedElement* shared = dynamic_cast<const SharedElement*>(&element);
+		if (shared != nullptr){
+			record = shared->GetRecord();
+			return record.type != SharedRecord::FREE_RECORD;
+		}
+		return false;
+	}
+	/**
+	 * Compares the elements of two records, the same as Integer::Equals and
+	 * Person::Equals would
+	 */
+	bool Same(const SharedRecord& lhs, const SharedRecord& rhs){
+		if (lhs.type != rhs.type){
+			return false;
+		}
+		if (lhs.type == SharedRecord::INTEGER_RECORD){
+			return lhs.value == rhs.value;
+		}
+		return lhs.type == SharedRecord::PERSON_RECORD && lhs.age == rhs.age && strcmp(lhs.name, rhs.name) == 0;
+	}
+	/**
+	 * Creates the object a record encodes
+	 * @param resource where the object is allocated
+	 * @return a new Integer or Person, nullptr for a free record
+	 */
+	Object* Decode(const SharedRecord& record, MemoryResource* resource){
+		if (record.type == SharedRecord::INTEGER_RECORD){
+			return new (resource) Integer(record.value);
+		}
+		if (record.type == SharedRecord::PERSON_RECORD){
+			return new (resource) Person(record.name, record.age, resource);
+		}
+		return nullptr;
+	}
+}
+
+/**
+ * Holds the mutex of a list for a scope
+ */
+class SharedList::Locker{
+	const SharedList& _list;
+public:
+	explicit Locker(const SharedList& list) : _list(list){
+		_list.Acquire();
+	}
+	~Locker(){
+		_list.Release();
+	}
+};
+
+/**
+ * Default Constructor
+ * The view is bound to a record by the list that owns it
+ */
+SharedElement::SharedElement() : _record(nullptr){
+
+}
+/**
+ * String representation, the same as the Integer or the Person
+ * @return the element, empty once the record is free
+ */
+string SharedElement::ToString()const{
+	std::stringstream retVal;
+	if (_record->type == SharedRecord::INTEGER_RECORD){
+		retVal << _record->value;
+	}else if (_record->type == SharedRecord::PERSON_RECORD){
+		retVal << "Person: {name: " << _record->name << ", age: " << _record->age << "}";
+	}
+	return retVal.str();
+}
+/**
+ * Compares the record with an Integer, a Person or another shared element
+ * @param rhs the object to compare to
+ * @return true if rhs encodes to the same element
+ */
+bool SharedElement::Equals(const Object& rhs)const{
+	if (this == &rhs){
+		return true;
+	}
+	SharedRecord record;
+	return Encode(rhs, record) && Same(*_record, record);
+}
+/**
+ * Hash code consistent with Equals, the same as the Integer or the Person
+ * @return the hash of the element
+ */
+size_t SharedElement::Hash()const{
+	if (_record->type == SharedRecord::INTEGER_RECORD){
+		return std::hash<int>()(_record->value);
+	}
+	return Person::HashOf(_record->name, _record->age);
+}
+/**
+ * Decodes the record, the copy does not change with the segment
+ * @return a new Integer or Person, nullptr once the record is free
+ */
+Object* SharedElement::Clone()const{
+	return Decode(*_record, MemoryResource::Default());
+}
+/**
+ * Decodes the record in a memory resource
+ * @param resource where the copy is allocated
+ * @return a new Integer or Person, nullptr once the record is free
+ */
+Object* SharedElement::Clone(MemoryResource* resource)const{
+	return Decode(*_record, resource);
+}
+/**
+ * Memory footprint, the record belongs to the segment
+ * @return the size of the view in bytes
+ */
+size_t SharedElement::FootprintBytes()const{
+	return sizeof(SharedElement);
+}
+/**
+ * Record accessor
+ * @return the record in the segment, read without the mutex of the list
+ */
+const SharedRecord& SharedElement::GetRecord()const{
+	return *_record;
+}
+
+/**
+ * Constructor
+ * Binds one view to every record of a mapped segment
+ * @param name the name of the segment
+ * @param owner true if the list created the segment
+ * @param base where the segment is mapped
+ * @param bytes the size of the mapping
+ */
+SharedList::SharedList(const string& name, bool owner, char* base, size_t bytes) : _name(name), _owner(owner),
+	_base(base), _bytes(bytes), _header(reinterpret_cast<Header*>(base)), _views(_header->capacity){
+	for (size_t i = 0; i < _views.size(); i++){
+		_views[i]._record = RecordAt(RECORDS + i * sizeof(SharedRecord));
+	}
+	Lock();
+	Unlock();
+}
+/**
+ * Bytes of a segment
+ * @param capacity the number of records
+ */
+size_t SharedList::SegmentBytes(size_t capacity){
+	return RECORDS + capacity * sizeof(SharedRecord);
+}
+/**
+ * Creates a segment and maps it
+ * @param name the name of the segment, as shm_open expects it: "/name"
+ * @param capacity the maximum number of elements
+ * @return the list, nullptr if the segment exists or cannot be created
+ */
+SharedList* SharedList::Create(const string& name, size_t capacity){
+	if (capacity == 0 || capacity > (SIZE_MAX - RECORDS) / sizeof(SharedRecord)){
+		return nullptr;
+	}
+	int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (descriptor < 0){
+		return nullptr;
+	}
+	size_t bytes = SegmentBytes(capacity);
+	void* base = MAP_FAILED;
+	if (ftruncate(descriptor, static_cast<off_t>(bytes)) == 0){
+		base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, SHARED_MAP_FLAGS, descriptor, 0);
+	}
+	close(descriptor);
+	if (base == MAP_FAILED){
+		shm_unlink(name.c_str());
+		return nullptr;
+	}
+	// ftruncate zero fills, every link is already 0
+	Header* header = static_cast<Header*>(base);
+	header->layout = LAYOUT;
+	header->capacity = capacity;
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	int result = pthread_mutex_init(&header->mutex, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+	if (result != 0){
+		munmap(base, bytes);
+		shm_unlink(name.c_str());
+		return nullptr;
+	}
+	__atomic_store_n(&header->magic, MAGIC, __ATOMIC_RELEASE);
+	return new SharedList(name, true, static_cast<char*>(base), bytes);
+}
+/**
+ * Maps a segment created by another list, in this or another process
+ * @param name the name given to Create
+ * @return the list, nullptr if there is no such segment or its layout differs
+ */
+SharedList* SharedList::Attach(const string& name){
+	int descriptor = shm_open(name.c_str(), O_RDWR, 0);
+	if (descriptor < 0){
+		return nullptr;
+	}
+	struct stat status;
+	void* base = MAP_FAILED;
+	if (fstat(descriptor, &status) == 0 && static_cast<size_t>(status.st_size) >= RECORDS){
+		base = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, SHARED_MAP_FLAGS, descriptor, 0);
+	}
+	close(descriptor);
+	if (base == MAP_FAILED){
+		return nullptr;
+	}
+	size_t bytes = status.st_size;
+	Header* header = static_cast<Header*>(base);
+	if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != MAGIC || header->layout != LAYOUT ||
+		header->capacity > (bytes - RECORDS) / sizeof(SharedRecord) || SegmentBytes(header->capacity) != bytes){
+		munmap(base, bytes);
+		return nullptr;
+	}
+	return new SharedList(name, false, static_cast<char*>(base), bytes);
+}
+/**
+ * Removes the name of a segment, the lists that mapped it keep working
+ * @param name the name given to Create
+ * @return false if there was no such segment
+ */
+bool SharedList::Unlink(const string& name){
+	return shm_unlink(name.c_str()) == 0;
+}
+/**
+ * Destructor
+ * Unmaps the segment, the elements stay for the other processes. The list
+ * that created the segment also removes its name.
+ */
+SharedList::~SharedList(){
+	munmap(_base, _bytes);
+	if (_owner){
+		shm_unlink(_name.c_str());
+	}
+}
+/**
+ * Record at an offset in this process
+ */
+SharedRecord* SharedList::RecordAt(uint64_t offset)const{
+	return reinterpret_cast<SharedRecord*>(_base + offset);
+}
+/**
+ * Finds a record walking from the closest end, the mutex must be held
+ * @param position a valid position
+ * @return the offset of the record
+ */
+uint64_t SharedList::OffsetAt(size_t position)const{
+	uint64_t retVal;
+	if (position < _header->size / 2){
+		LIST_STATS_ADD(hops, position);
+		retVal = _header->head;
+		for (size_t i = 0; i < position; i++){
+			retVal = RecordAt(retVal)->next;
+		}
+	}else{
+		LIST_STATS_ADD(hops, _header->size - 1 - position);
+		retVal = _header->tail;
+		for (size_t i = _header->size - 1; i > position; i--){
+			retVal = RecordAt(retVal)->previous;
+		}
+	}
+	return retVal;
+}
+/**
+ * Locks the mutex of the segment. A process that died holding it may have
+ * left a change half done, the links are taken as they are.
+ */
+void SharedList::Acquire()const{
+	if (pthread_mutex_lock(&_header->mutex) == EOWNERDEAD){
+		pthread_mutex_consistent(&_header->mutex);
+	}
+}
+void SharedList::Release()const{
+	pthread_mutex_unlock(&_header->mutex);
+}
+/**
+ * Inserts an element, encoding it in a free record
+ * @param element an Integer or a Person, deleted once it is encoded
+ * @param position where the element goes
+ * @return false if the position is invalid, the segment is full or the
+ * element cannot be encoded, the caller keeps the element then
+ */
+bool SharedList::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	{
+		Locker locker(*this);
+		Header& header = *_header;
+		// Views belong to a list, insert their Clone instead
+		if (position > header.size || (header.free == 0 && header.used == header.capacity) ||
+			dynamic_cast<SharedElement*>(element) != nullptr){
+			return false;
+		}
+		uint64_t offset = header.free != 0 ? header.free : RECORDS + header.used * sizeof(SharedRecord);
+		SharedRecord* record = RecordAt(offset);
+		if (!Encode(*element, *record)){
+			return false;
+		}
+		if (header.free != 0){
+			header.free = record->next;
+		}else{
+			header.used++;
+		}
+		if (position == header.size){
+			record->next = 0;
+			record->previous = header.tail;
+		}else{
+			record->next = OffsetAt(position);
+			record->previous = RecordAt(record->next)->previous;
+		}
+		*(record->previous != 0 ? &RecordAt(record->previous)->next : &header.head) = offset;
+		*(record->next != 0 ? &RecordAt(record->next)->previous : &header.tail) = offset;
+		_size = ++header.size;
+		_version = ++header.version;
+	}
+	delete element;
+	return true;
+}
+/**
+ * Position of the first element equal to element, compares the records
+ * without decoding them. The filter is not used, other processes change the
+ * list behind it.
+ * @param element an Integer, a Person or a view of a shared list
+ * @return the position, -1 if there is none
+ */
+int SharedList::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	SharedRecord key;
+	if (element == nullptr || !Encode(*element, key)){
+		return -1;
+	}
+	Locker locker(*this);
+	int position = 0;
+	for (uint64_t offset = _header->head; offset != 0; offset = RecordAt(offset)->next){
+		if (Same(*RecordAt(offset), key)){
+			return position;
+		}
+		position++;
+	}
+	return -1;
+}
+/**
+ * Removes an element, decoding it out of the segment
+ * @param position the element to remove
+ * @return a new Integer or Person, the caller owns it, nullptr if the
+ * position is invalid
+ */
+Object* SharedList::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	Locker locker(*this);
+	Header& header = *_header;
+	if (position >= header.size){
+		return nullptr;
+	}
+	uint64_t offset = OffsetAt(position);
+	SharedRecord* record = RecordAt(offset);
+	*(record->previous != 0 ? &RecordAt(record->previous)->next : &header.head) = record->next;
+	*(record->next != 0 ? &RecordAt(record->next)->previous : &header.tail) = record->previous;
+	Object* retVal = Decode(*record, MemoryResource::Default());
+	record->type = SharedRecord::FREE_RECORD;
+	record->next = header.free;
+	header.free = offset;
+	_size = --header.size;
+	_version = ++header.version;
+	return retVal;
+}
+/**
+ * Element accessor, nothing is copied
+ * @return a view of the record at position, owned by the list, nullptr if
+ * the position is invalid
+ */
+Object* SharedList::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	Locker locker(*this);
+	if (position >= _header->size){
+		return nullptr;
+	}
+	return &_views[(OffsetAt(position) - RECORDS) / sizeof(SharedRecord)];
+}
+/**
+ * String representation of the elements, {2, 6, 8}
+ */
+string SharedList::ToString()const{
+	std::stringstream retVal;
+	retVal << "{";
+	Locker locker(*this);
+	for (uint64_t offset = _header->head; offset != 0; offset = RecordAt(offset)->next){
+		retVal << (offset == _header->head ? "" : ", ") << _views[(offset - RECORDS) / sizeof(SharedRecord)].ToString();
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Frees every record, the list is left empty for every process
+ */
+void SharedList::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	Locker locker(*this);
+	Header& header = *_header;
+	for (uint64_t offset = header.head; offset != 0; offset = RecordAt(offset)->next){
+		RecordAt(offset)->type = SharedRecord::FREE_RECORD;
+	}
+	header.used = 0;
+	header.free = header.head = header.tail = 0;
+	_size = header.size = 0;
+	_version = ++header.version;
+}
+/**
+ * The header and the views are counted with the list, the records are the
+ * storage. The segment is shared, every attached list reports it.
+ * @return the bytes used by the list, the elements are part of the records
+ */
+ListMemoryUsage SharedList::MemoryUsage()const{
+	Locker locker(*this);
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(SharedList) + RECORDS + _views.capacity() * sizeof(SharedElement) + FilterBytes();
+	retVal.storage = _header->size * sizeof(SharedRecord);
+	retVal.unused = (_header->capacity - _header->size) * sizeof(SharedRecord);
+	return retVal;
+}
+/**
+ * Visits the views of the records in order, holding the mutex so other
+ * processes cannot change the list during the walk
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool SharedList::Walk(ElementVisitor& visitor)const{
+	Locker locker(*this);
+	for (uint64_t offset = _header->head; offset != 0; offset = RecordAt(offset)->next){
+		if (!visitor.Visit(&_views[(offset - RECORDS) / sizeof(SharedRecord)])){
+			return false;
+		}
+	}
+	return true;
+}
+/**
+ * Locks the list for a sequence of operations of this process, the others
+ * wait until Unlock. Size and GetVersion are refreshed from the segment, as
+ * they are after every change made through this list.
+ */
+void SharedList::Lock(){
+	Acquire();
+	_size = _header->size;
+	_version = _header->version;
+}
+void SharedList::Unlock(){
+	Release();
+}
+/**
+ * Size of the list including the changes of other processes
+ * @return the number of elements in the segment
+ */
+size_t SharedList::SharedSize()const{
+	Locker locker(*this);
+	return _header->size;
+}
+/**
+ * Capacity accessor
+ * @return the number of records in the segment
+ */
+size_t SharedList::GetCapacity()const{
+	return _header->capacity;
+}
+const string& SharedList::GetName()const{
+	return _name;
+}
@@ -0,0 +1,109 @@
+/*
+ * Title:		Shared List
+ * Purpose:		Declaration of a list placed in a POSIX shared memory segment,
+ * 				so processes on the same host exchange Integer and Person
+ * 				elements without serializing them. The segment holds a header
+ * 				and a fixed number of records. Records are linked by their
+ * 				offset from the start of the segment, never by pointers, so
+ * 				every process may map the segment at a different address. A
+ * 				process shared mutex in the header serializes the operations.
+ *
+ * 				Elements are encoded in place: Insert copies an Integer or a
+ * 				Person into a record and deletes it, Remove decodes the record
+ * 				into a new object. Get returns a view owned by the list that
+ * 				reads the record in the segment, and IndexOf compares the
+ * 				records without creating any object.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef SHARED_LIST_H
+#define SHARED_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+/**
+ * Fixed layout of an element in the segment, one cache line. The layout is
+ * the same in every process that maps the segment.
+ */
+struct SharedRecord{
+	static const size_t NAME_CAPACITY = 32;		// Names up to 31 characters
+	enum Type : uint32_t {FREE_RECORD, INTEGER_RECORD, PERSON_RECORD};
+	uint64_t next;				// Offset of the next record, 0 for none
+	uint64_t previous;			// Offset of the previous record, 0 for none
+	uint32_t type;
+	int32_t value;				// Integer value
+	uint64_t age;				// Person age
+	char name[NAME_CAPACITY];	// Person name, NUL terminated
+};
+
+/**
+ * Element returned by SharedList::Get. It reads its record every time it is
+ * used and compares equal to the Integer or Person the record encodes. Once
+ * the element is removed the record may hold a different element.
+ */
+class SharedElement final : public Object{
+	const SharedRecord* _record;
+	friend class SharedList;
+public:
+	SharedElement();
+	virtual string ToString()const;
+	virtual bool Equals(const Object& rhs)const;
+	virtual size_t Hash()const;
+	virtual Object* Clone()const;
+	virtual Object* Clone(MemoryResource* resource)const;
+	virtual size_t FootprintBytes()const;
+	const SharedRecord& GetRecord()const;
+};
+
+class SharedList final : public List{
+	struct Header;
+	static const size_t RECORDS;	// Offset of the first record
+	string _name;
+	bool _owner;			// Created the segment, unlinks the name when destroyed
+	char* _base;			// Where the segment is mapped in this process
+	size_t _bytes;
+	Header* _header;
+	mutable vector<SharedElement> _views;	// One per record, returned by Get
+	SharedList(const string& name, bool owner, char* base, size_t bytes);
+	SharedList(const SharedList&);
+	const SharedList& operator=(const SharedList&);
+	SharedRecord* RecordAt(uint64_t offset)const;
+	uint64_t OffsetAt(size_t position)const;
+	void Acquire()const;
+	void Release()const;
+	class Locker;
+	static size_t SegmentBytes(size_t capacity);
+public:
+	static const uint32_t MAGIC = 0x54534c53;	// "SLST"
+	static const uint32_t LAYOUT = 1;			// Changes with SharedRecord or the header
+
+	static SharedList* Create(const string& name, size_t capacity);
+	static SharedList* Attach(const string& name);
+	static bool Unlink(const string& name);
+	virtual ~SharedList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+
+	void Lock();
+	void Unlock();
+	size_t SharedSize()const;
+	size_t GetCapacity()const;
+	const string& GetName()const;
+};
+
+#endif
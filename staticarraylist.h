@@ -0,0 +1,243 @@
+/*
+ * Title:		Static Array List
+ * Purpose:		Declaration and implementation of a list with a capacity fixed
+ * 				at compile time. The element pointers are stored inside the
+ * 				list object, so a StaticArrayList on the stack or embedded in
+ * 				another object never allocates. Insert fails once the list is
+ * 				full. Only the opt-in IndexOf filter allocates, and a
+ * 				reclaimer is ignored: Clear and the destructor always delete
+ * 				the elements in place.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef STATIC_ARRAY_LIST_H
+#define STATIC_ARRAY_LIST_H
+
+#include "object.h"
+#include "list.h"
+
+#include <climits>
+#include <cstddef>
+#include <sstream>
+#include <string>
+using std::string;
+
+template <size_t N>
+class StaticArrayList final : public List{
+	static_assert(N > 0 && N <= INT_MAX, "The capacity must be positive and positions must fit IndexOf");
+
+	Object* _data[N];
+	StaticArrayList(const StaticArrayList&);
+	const StaticArrayList& operator=(const StaticArrayList&);
+	virtual void FillFilter()const;
+public:
+	static constexpr size_t CAPACITY = N;
+
+	StaticArrayList();
+	virtual ~StaticArrayList();
+
+	virtual bool Insert(Object* element, size_t position);
+	virtual int IndexOf(const Object* element)const;
+	virtual Object* Remove(size_t position);
+	virtual Object* Get(size_t position)const;
+	virtual string ToString()const;
+	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+
+	static constexpr size_t GetCapacity(){
+		return N;
+	}
+	bool IsFull()const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
+};
+
+template <size_t N>
+constexpr size_t StaticArrayList<N>::CAPACITY;
+
+/**
+ * Default Constructor
+ * Starts empty, the slots are not initialized
+ */
+template <size_t N>
+StaticArrayList<N>::StaticArrayList(){
+
+}
+/**
+ * Destructor
+ * Deletes the elements, the slots go away with the list
+ */
+template <size_t N>
+StaticArrayList<N>::~StaticArrayList(){
+	for (size_t i = 0; i < _size; i++){
+		delete _data[i];
+	}
+}
+/**
+ * Inserts an element, shifting the elements after it
+ * @param element the element, the list owns it if it is inserted
+ * @param position where the element goes
+ * @return false if the position is invalid or the list is full
+ */
+template <size_t N>
+bool StaticArrayList<N>::Insert(Object* element, size_t position){
+	LIST_STATS_SCOPE(INSERT);
+	if (position > _size || _size == N){
+		return false;
+	}
+	LIST_STATS_ADD(shifts, _size - position);
+	for (size_t i = _size; i > position; i--){
+		_data[i] = _data[i - 1];
+	}
+	_data[position] = element;
+	_size++;
+	_version++;
+	FilterAdd(element);
+	return true;
+}
+/**
+ * Position of the first element equal to element
+ * @return the position, -1 if there is none
+ */
+template <size_t N>
+int StaticArrayList<N>::IndexOf(const Object* element)const{
+	LIST_STATS_SCOPE(INDEX_OF);
+	if (FilterExcludes(element)){
+		return -1;
+	}
+	for (size_t i = 0; i < _size; i++){
+		if (_data[i]->Equals(*element)){
+			return static_cast<int>(i);
+		}
+	}
+	FilterMissed();
+	return -1;
+}
+/**
+ * Removes an element, shifting the elements after it
+ * @param position the element to remove
+ * @return the element, the caller owns it, nullptr if the position is invalid
+ */
+template <size_t N>
+Object* StaticArrayList<N>::Remove(size_t position){
+	LIST_STATS_SCOPE(REMOVE);
+	if (position >= _size){
+		return nullptr;
+	}
+	LIST_STATS_ADD(shifts, _size - position - 1);
+	Object* retVal = _data[position];
+	for (size_t i = position; i + 1 < _size; i++){
+		_data[i] = _data[i + 1];
+	}
+	_size--;
+	_version++;
+	FilterRemoved();
+	return retVal;
+}
+/**
+ * Element accessor
+ * @return the element at position, nullptr if the position is invalid
+ */
+template <size_t N>
+Object* StaticArrayList<N>::Get(size_t position)const{
+	LIST_STATS_SCOPE(GET);
+	return position < _size ? _data[position] : nullptr;
+}
+/**
+ * String representation of the elements, {2, 6, 8}
+ */
+template <size_t N>
+string StaticArrayList<N>::ToString()const{
+	std::stringstream retVal;
+	retVal << "{";
+	for (size_t i = 0; i < _size; i++){
+		retVal << (i == 0 ? "" : ", ") << _data[i]->ToString();
+	}
+	retVal << "}";
+	return retVal.str();
+}
+/**
+ * Deletes every element, the list is left empty
+ */
+template <size_t N>
+void StaticArrayList<N>::Clear(){
+	LIST_STATS_SCOPE(CLEAR);
+	FilterInvalidate();
+	for (size_t i = 0; i < _size; i++){
+		delete _data[i];
+	}
+	_size = 0;
+	_version++;
+}
+/**
+ * The slots are part of the list object, they are reported as storage and
+ * unused capacity instead of container bytes
+ * @return the bytes used by the list and its elements
+ */
+template <size_t N>
+ListMemoryUsage StaticArrayList<N>::MemoryUsage()const{
+	ListMemoryUsage retVal;
+	retVal.container = sizeof(StaticArrayList) - sizeof(_data) + FilterBytes();
+	retVal.storage = _size * sizeof(Object*);
+	retVal.unused = (N - _size) * sizeof(Object*);
+	for (size_t i = 0; i < _size; i++){
+		retVal.elements += _data[i]->FootprintBytes();
+	}
+	return retVal;
+}
+/**
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+template <size_t N>
+bool StaticArrayList<N>::Walk(ElementVisitor& visitor)const{
+	return Visit([&visitor](Object* element){
+		return visitor.Visit(element);
+	});
+}
+/**
+ * Checks if the list keeps a filter up to date
+ * @return true, the same as VSArray
+ */
+template <size_t N>
+bool StaticArrayList<N>::SupportsFilter()const{
+	return true;
+}
+/**
+ * @return true if Insert would fail for every position
+ */
+template <size_t N>
+bool StaticArrayList<N>::IsFull()const{
+	return _size == N;
+}
+/**
+ * Adds every element to the filter without going through Get
+ */
+template <size_t N>
+void StaticArrayList<N>::FillFilter()const{
+	for (size_t i = 0; i < _size; i++){
+		_filter->Add(_data[i]->Hash());
+	}
+}
+/**
+ * Visits the elements in order without virtual dispatch. Used by the
+ * algorithms in algorithms.h.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <size_t N>
+template <class Visitor>
+bool StaticArrayList<N>::Visit(Visitor visitor)const{
+	for (size_t i = 0; i < _size; i++){
+		if (!visitor(_data[i])){
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * Title:		Sub List Views
+ * Purpose:		Non-owning views of a window of a VSArray or a
+ * 				DoubleLinkedList. A view stores where the window starts and
+ * 				its length; elements are never cloned or copied. The view of a
+ * 				DoubleLinkedList keeps the boundary nodes of the window, so its
+ * 				accesses start in the middle of the list.
+ *
+ * 				A view remembers the version of its list. Once the list is
+ * 				changed the view is no longer valid and behaves as an empty
+ * 				view; IsValid tells them apart. A view must not outlive its
+ * 				list.
+ * Author:		Carlos Arias
+ * Date:		October 19, 2026
+ */
+#ifndef SUB_LIST_H
+#define SUB_LIST_H
+
+#include "object.h"
+#include "vsarray.h"
+#include "dlinkedlist.h"
+
+#include <sstream>
+#include <string>
+using std::string;
+
+template <class ListType>
+class SubList;
+
+/**
+ * Operations shared by every view, written on top of the view's Size,
+ * IsValid and Visit
+ */
+template <class View>
+class SubListBase{
+	const View& Self()const{
+		return static_cast<const View&>(*this);
+	}
+public:
+	bool IsEmpty()const{
+		return Self().Size() == 0;
+	}
+	/**
+	 * Position of the first element equal to element, relative to the
+	 * start of the view
+	 * @return the position, -1 if it is not in the view or the view is
+	 * no longer valid
+	 */
+	int IndexOf(const Object* element)const{
+		int index = 0;
+		bool found = Self().IsValid() && !Self().Visit([&index, element](Object* current){
+			if (current->Equals(*element)){
+				return false;
+			}
+			index++;
+			return true;
+		});
+		return found ? index : -1;
+	}
+	/**
+	 * String representation of the elements in the view, {2, 6, 8}
+	 */
+	string ToString()const{
+		std::stringstream retVal;
+		retVal << "{";
+		bool first = true;
+		Self().Visit([&retVal, &first](Object* current){
+			retVal << (first ? "" : ", ") << current->ToString();
+			first = false;
+			return true;
+		});
+		retVal << "}";
+		return retVal.str();
+	}
+};
+
+/**
+ * View of a window of a VSArray, the elements are read straight from the
+ * array of the list
+ */
+template <>
+class SubList<VSArray> : public SubListBase<SubList<VSArray> >{
+	const VSArray* _list;
+	size_t _offset;
+	size_t _length;
+	unsigned long long _version;
+public:
+	/**
+	 * Constructor
+	 * The window is clipped to the elements of the list
+	 * @param list the list that is viewed
+	 * @param offset the position of the first element of the view
+	 * @param length the number of elements in the view
+	 */
+	SubList(const VSArray& list, size_t offset, size_t length) : _list(&list), _version(list.GetVersion()){
+		_offset = offset < list.Size() ? offset : list.Size();
+		_length = length < list.Size() - _offset ? length : list.Size() - _offset;
+	}
+	bool IsValid()const{
+		return _list->GetVersion() == _version;
+	}
+	size_t Size()const{
+		return IsValid() ? _length : 0;
+	}
+	/**
+	 * Element at a position of the view
+	 * @return the element, nullptr if the position is not in the view
+	 */
+	Object* Get(size_t position)const{
+		return position < Size() ? _list->_data[_offset + position] : nullptr;
+	}
+	/**
+	 * Visits the elements of the view in order
+	 * @param visitor called with each element, returns false to stop
+	 * @return true if every element was visited
+	 */
+	template <class Visitor>
+	bool Visit(Visitor visitor)const{
+		Object* const* data = _list->_data + _offset;
+		for (size_t i = 0; i < Size(); i++){
+			if (!visitor(data[i])){
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/**
+ * View of a window of a DoubleLinkedList, anchored on the first and the
+ * last node of the window. Get walks from the closest of the two.
+ */
+template <>
+class SubList<DoubleLinkedList> : public SubListBase<SubList<DoubleLinkedList> >{
+	typedef DoubleLinkedList::Node Node;
+	const DoubleLinkedList* _list;
+	Node* _first;
+	Node* _last;
+	size_t _length;
+	unsigned long long _version;
+public:
+	/**
+	 * Constructor
+	 * Finds the boundary nodes, walking from the closest end of the list.
+	 * The window is clipped to the elements of the list.
+	 * @param list the list that is viewed
+	 * @param offset the position of the first element of the view
+	 * @param length the number of elements in the view
+	 */
+	SubList(const DoubleLinkedList& list, size_t offset, size_t length) : _list(&list), _first(nullptr),
+		_last(nullptr), _version(list.GetVersion()){
+		offset = offset < list.Size() ? offset : list.Size();
+		_length = length < list.Size() - offset ? length : list.Size() - offset;
+		if (_length > 0){
+			_first = list.NodeAt(offset);
+			_last = list.NodeAt(offset + _length - 1);
+		}
+	}
+	bool IsValid()const{
+		return _list->GetVersion() == _version;
+	}
+	size_t Size()const{
+		return IsValid() ? _length : 0;
+	}
+	/**
+	 * Element at a position of the view
+	 * @return the element, nullptr if the position is not in the view
+	 */
+	Object* Get(size_t position)const{
+		if (position >= Size()){
+			return nullptr;
+		}
+		Node* tmp = nullptr;
+		if (position < _length / 2){
+			tmp = _first;
+			for (size_t i = 0; i < position; i++){
+				tmp = tmp->next;
+			}
+		}else{
+			tmp = _last;
+			for (size_t i = _length - 1; i > position; i--){
+				tmp = tmp->previous;
+			}
+		}
+		return tmp->data;
+	}
+	/**
+	 * Visits the elements of the view in order
+	 * @param visitor called with each element, returns false to stop
+	 * @return true if every element was visited
+	 */
+	template <class Visitor>
+	bool Visit(Visitor visitor)const{
+		Node* tmp = _first;
+		for (size_t i = 0; i < Size(); i++, tmp = tmp->next){
+			if (!visitor(tmp->data)){
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+#endif
@@ -3,12 +3,35 @@
 #include "list.h"
 #include "dlinkedlist.h"
 #include "vsarray.h"
+#include "adaptivelist.h"
+#include "cowlist.h"
+#include "intrusivelist.h"
+#include "indexlinkedlist.h"
+#include "algorithms.h"
+#include "reclaimer.h"
+#include "memoryresource.h"
+#include "recordloader.h"
+#include "sublist.h"
+#include "editbatch.h"
+#include "parallel.h"
+#include "staticarraylist.h"
+#include "sharedlist.h"
+#include "lrucache.h"
+#include "columnlist.h"
+#include "gapbufferlist.h"
+#include "perfcounters.h"
+#include "objectcounters.h"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
 using std::cout;
 using std::endl;
 using std::string;
@@ -16,16 +39,48 @@ using std::stringstream;
 using std::setw;
 using std::fixed;
 using std::setprecision;
+using std::vector;
 
 void Test(List*, const string&, bool=true);
+void TestStats();
+void TestMemory();
+void TestAdaptive();
+void TestSnapshot();
+void TestIntrusive();
+void TestCompact();
+void TestSplice();
+void TestAlgorithms();
+void TestReclaim();
+void TestResource();
+void TestFilter();
+void TestLoader();
+void TestSubList();
+void TestEditBatch();
+void TestDefragment();
+void TestDeepCopy();
+void TestStatic();
+void TestShared();
+void TestLruCache();
+void TestColumns();
+void TestMultiSearch();
+void TestPerfCounters();
+void TestGapBuffer();
+string SharedName(const string& suffix);
 
 
 int main(int argc, char* argv[]){
 	cout << "====================================" << endl;
 	cout << endl << endl;
-	cout << "There are 2 sets of unit tests:" << endl;
+	cout << "There are 9 sets of unit tests:" << endl;
 	cout << "   1. Double Linked List        - 55" << endl;
 	cout << "   2. Variable Size Array List  - 55" << endl;
+	cout << "   3. Adaptive List             - 55" << endl;
+	cout << "   4. Copy-On-Write List        - 55" << endl;
+	cout << "   5. Index Linked List         - 55" << endl;
+	cout << "   6. Static Array List         - 55" << endl;
+	cout << "   7. Shared List               - 55" << endl;
+	cout << "   8. Column List               - 55" << endl;
+	cout << "   9. Gap Buffer List           - 55" << endl;
 	cout << "====================================" << endl;
 	cout << "====================================" << endl;
 	cout << endl << endl;
@@ -36,6 +91,96 @@ int main(int argc, char* argv[]){
 	cout << "Variable Size Array List Tests" << endl;
 	Test(new VSArray(5), "Variable Size Array List", false);
 
+	cout << "Adaptive List Tests" << endl;
+	Test(new AdaptiveList(5), "Adaptive List", false);
+
+	cout << "Copy-On-Write List Tests" << endl;
+	Test(new CowList(), "Copy-On-Write List", false);
+
+	cout << "Index Linked List Tests" << endl;
+	Test(new IndexLinkedList(2), "Index Linked List", false);
+
+	cout << "Static Array List Tests" << endl;
+	Test(new StaticArrayList<5>(), "Static Array List", true);
+
+	cout << "Shared List Tests" << endl;
+	Test(SharedList::Create(SharedName("unit"), 5), "Shared List", true);
+
+	cout << "Column List Tests" << endl;
+	Test(new ColumnList(), "Column List", false);
+
+	cout << "Gap Buffer List Tests" << endl;
+	Test(new GapBufferList(2), "Gap Buffer List", false);
+
+	cout << "List Statistics Tests" << endl;
+	TestStats();
+
+	cout << "Memory Usage Tests" << endl;
+	TestMemory();
+
+	cout << "Adaptive Migration Tests" << endl;
+	TestAdaptive();
+
+	cout << "Snapshot Tests" << endl;
+	TestSnapshot();
+
+	cout << "Intrusive List Tests" << endl;
+	TestIntrusive();
+
+	cout << "Compact Tests" << endl;
+	TestCompact();
+
+	cout << "Splice Tests" << endl;
+	TestSplice();
+
+	cout << "Algorithm Tests" << endl;
+	TestAlgorithms();
+
+	cout << "Deferred Destruction Tests" << endl;
+	TestReclaim();
+
+	cout << "Memory Resource Tests" << endl;
+	TestResource();
+
+	cout << "IndexOf Filter Tests" << endl;
+	TestFilter();
+
+	cout << "Record Loader Tests" << endl;
+	TestLoader();
+
+	cout << "Sub List Tests" << endl;
+	TestSubList();
+
+	cout << "Edit Batch Tests" << endl;
+	TestEditBatch();
+
+	cout << "Defragment Tests" << endl;
+	TestDefragment();
+
+	cout << "Deep Copy Tests" << endl;
+	TestDeepCopy();
+
+	cout << "Static Array List Tests" << endl;
+	TestStatic();
+
+	cout << "Shared List Tests" << endl;
+	TestShared();
+
+	cout << "LRU Cache Tests" << endl;
+	TestLruCache();
+
+	cout << "Column List Tests" << endl;
+	TestColumns();
+
+	cout << "Multi-Key Search Tests" << endl;
+	TestMultiSearch();
+
+	cout << "Performance Counter Tests" << endl;
+	TestPerfCounters();
+
+	cout << "Gap Buffer Tests" << endl;
+	TestGapBuffer();
+
 	cout << "- - - - - - - - - - - - - - - - - - - " << endl;
 	cout << endl;
 	cout << "    C O N G R A T U L A T I O N S" << endl;
@@ -256,4 +401,1186 @@ void Test(List* list, const string& message, bool fixedSize){
 	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
 	cout << endl << "F i n i s h e d   S u c c e s s f u l l y" << endl;
 
-}
\ No newline at end of file
+}
+
+void TestStats(){
+	VSArray array(2);
+	DoubleLinkedList linked;
+	Integer SEVEN(7);
+	for (int i = 0; i < 3; i++) {
+		assert(array.Insert(new Integer(i), 0) == true);
+		assert(linked.Insert(new Integer(i), 0) == true);
+	}
+	assert(array.Get(2)->ToString() == "0");
+	assert(linked.Get(2)->ToString() == "0");
+	assert(array.IndexOf(&SEVEN) == -1);
+	delete array.Remove(0);
+	array.Clear();
+	linked.Clear();
+
+	ListStats arrayStats = array.Stats();
+	ListStats linkedStats = linked.Stats();
+#ifdef LIST_STATS
+	assert(arrayStats.calls[ListStats::INSERT] == 3);
+	assert(arrayStats.calls[ListStats::GET] == 1);
+	assert(arrayStats.calls[ListStats::INDEX_OF] == 1);
+	assert(arrayStats.calls[ListStats::REMOVE] == 1);
+	assert(arrayStats.calls[ListStats::CLEAR] == 1);
+	assert(arrayStats.shifts == 0 + 1 + 2 + 2);
+	assert(arrayStats.resizes == 1);
+	assert(arrayStats.bytesMoved == 2 * sizeof(Object*));
+	assert(linkedStats.calls[ListStats::INSERT] == 3);
+	assert(linkedStats.hops == 2);
+	unsigned long long histogram = 0;
+	for (size_t b = 0; b < ListStats::BUCKETS; b++) {
+		histogram += arrayStats.latency[ListStats::INSERT][b];
+	}
+	assert(histogram == 3);
+	assert(arrayStats.ToJson().find("\"Insert\": {\"calls\": 3") != string::npos);
+	array.ResetStats();
+	assert(array.Stats().calls[ListStats::INSERT] == 0);
+#else
+	for (size_t op = 0; op < ListStats::OPERATION_COUNT; op++) {
+		assert(arrayStats.calls[op] == 0);
+		assert(linkedStats.calls[op] == 0);
+	}
+#endif
+	cout << arrayStats.ToString();
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestMemory(){
+#ifdef OBJECT_COUNTERS
+	ObjectCounters::Snapshot before = ObjectCounters::Get();
+#endif
+	VSArray array(4);
+	DoubleLinkedList linked;
+	assert(array.Insert(new Integer(1), 0) == true);
+	assert(array.Insert(new Person("Ann", 30), 1) == true);
+	assert(linked.Insert(new Integer(1), 0) == true);
+	assert(linked.Insert(new Person("Ann", 30), 1) == true);
+
+	const size_t ELEMENTS = sizeof(Integer) + sizeof(Person) + 4;
+	assert(array.Get(1)->FootprintBytes() == sizeof(Person) + 4);
+
+	ListMemoryUsage usage = array.MemoryUsage();
+	assert(usage.container == sizeof(VSArray));
+	assert(usage.storage == 2 * sizeof(Object*));
+	assert(usage.unused == 2 * sizeof(Object*));
+	assert(usage.elements == ELEMENTS);
+	assert(array.FootprintBytes() == usage.Total());
+
+	usage = linked.MemoryUsage();
+	assert(usage.container == sizeof(DoubleLinkedList));
+	assert(usage.storage == 2 * 3 * sizeof(void*));
+	assert(usage.unused == 0);
+	assert(usage.elements == ELEMENTS);
+	cout << usage.ToString() << endl;
+
+#ifdef OBJECT_COUNTERS
+	ObjectCounters::Snapshot during = ObjectCounters::Get();
+	assert(during.live[ObjectCounters::TYPE_INTEGER] - before.live[ObjectCounters::TYPE_INTEGER] == 2);
+	assert(during.live[ObjectCounters::TYPE_PERSON] - before.live[ObjectCounters::TYPE_PERSON] == 2);
+	assert(during.liveBytes[ObjectCounters::TYPE_PERSON] - before.liveBytes[ObjectCounters::TYPE_PERSON]
+		== static_cast<long long>(2 * (sizeof(Person) + 4)));
+	array.Clear();
+	linked.Clear();
+	ObjectCounters::Snapshot after = ObjectCounters::Get();
+	assert(after.live[ObjectCounters::TYPE_INTEGER] == before.live[ObjectCounters::TYPE_INTEGER]);
+	assert(after.liveBytes[ObjectCounters::TYPE_PERSON] == before.liveBytes[ObjectCounters::TYPE_PERSON]);
+	assert(after.created[ObjectCounters::TYPE_PERSON] - before.created[ObjectCounters::TYPE_PERSON] == 2);
+	cout << after.ToString();
+#endif
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestAdaptive(){
+	const int N = 1000;
+	AdaptiveList list(4);
+	Object* first = nullptr;
+	assert(list.GetRepresentation() == AdaptiveList::ARRAY);
+
+	// Bulk load at the front, every insert shifts the whole array
+	for (int i = N - 1; i >= 0; i--) {
+		assert(list.Insert(new Integer(i), 0) == true);
+		if (i == N - 1) {
+			first = list.Get(0);
+		}
+	}
+	assert(list.GetRepresentation() == AdaptiveList::LINKED);
+	assert(list.Size() == static_cast<size_t>(N));
+
+	// Random access deep into the list
+	for (int i = 0; i < 4 * static_cast<int>(AdaptiveList::WINDOW); i++) {
+		assert(list.Get((i * 37) % N)->ToString() == Integer((i * 37) % N).ToString());
+	}
+	assert(list.GetRepresentation() == AdaptiveList::ARRAY);
+	assert(list.GetMigrations() == 2);
+	// Migrations move the pointers, they do not clone
+	assert(list.Get(N - 1) == first);
+
+	// Queue drain at the back of the array is cheap, no migration
+	while (!list.IsEmpty()) {
+		delete list.Remove(list.Size() - 1);
+	}
+	assert(list.GetRepresentation() == AdaptiveList::ARRAY);
+	assert(list.GetMigrations() == 2);
+
+	list.Migrate(AdaptiveList::LINKED);
+	assert(list.GetRepresentation() == AdaptiveList::LINKED);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestSnapshot(){
+	const int N = 3 * CowList::CHUNK;
+	CowList list;
+	for (int i = 0; i < N; i++) {
+		assert(list.Insert(new Integer(i), list.Size()) == true);
+	}
+	CowList* snapshot = list.Snapshot();
+	assert(snapshot->Shares(list));
+	assert(snapshot->Get(N / 2) == list.Get(N / 2));
+
+	// Writes after the snapshot are not visible through it
+	assert(list.Insert(new Person("Ada", 36), N / 2) == true);
+	assert(!snapshot->Shares(list));
+	assert(snapshot->Size() == static_cast<size_t>(N));
+	assert(snapshot->Get(N / 2)->ToString() == Integer(N / 2).ToString());
+	assert(list.Get(N / 2 + 1) == snapshot->Get(N / 2));
+	// Chunks that were not modified are still shared
+	assert(list.Get(0) == snapshot->Get(0));
+
+	// Removing a shared element hands out a copy, the snapshot keeps the original
+	Object* removed = list.Remove(0);
+	assert(removed != snapshot->Get(0));
+	assert(removed->Equals(*snapshot->Get(0)));
+	delete removed;
+
+	list.Clear();
+	assert(snapshot->Size() == static_cast<size_t>(N));
+	Integer LAST(N - 1);
+	assert(snapshot->IndexOf(&LAST) == N - 1);
+	delete snapshot;
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestIntrusive(){
+	IntrusiveList list;
+	Integer* plain = new Integer(1);
+	assert(list.Insert(plain, 0) == false);
+	delete plain;
+
+	Linkable<Integer>* one = new Linkable<Integer>(1);
+	Linkable<Person>* ann = new Linkable<Person>("Ann", 30);
+	Linkable<Integer>* three = new Linkable<Integer>(3);
+	assert(list.Insert(three, 0) == true);
+	assert(list.Insert(one, 0) == true);
+	assert(list.Insert(ann, 1) == true);
+	assert(list.Insert(one, 0) == false);
+	assert(list.ToString() == "{1, Person: {name: Ann, age: 30}, 3}");
+	assert(list.Get(2) == three);
+	Integer THREE(3);
+	assert(list.IndexOf(&THREE) == 2);
+
+	// Known elements are removed without searching
+	assert(list.Unlink(ann) == true);
+	assert(list.Unlink(ann) == false);
+	assert(list.Size() == 2);
+	assert(list.Insert(ann, 2) == true);
+
+	// Copies are not linked, deleting a linked element unlinks it
+	Object* copy = ann->Clone();
+	assert(!list.Contains(copy));
+	assert(list.Insert(copy, 0) == true);
+	delete one;
+	assert(list.Size() == 3);
+	assert(list.ToString() == "{Person: {name: Ann, age: 30}, 3, Person: {name: Ann, age: 30}}");
+	assert(list.MemoryUsage().storage == 0);
+
+	assert(list.Remove(1) == three);
+	delete three;
+	list.Clear();
+	assert(list.IsEmpty());
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestCompact(){
+	IndexLinkedList list(4);
+	for (int i = 0; i < 20; i++) {
+		assert(list.Insert(new Integer(i), i % 2 == 0 ? 0 : list.Size()) == true);
+	}
+	for (int i = 0; i < 5; i++) {
+		delete list.Remove(3 * i);
+	}
+	// Reuses the free nodes before growing
+	size_t capacity = list.GetCapacity();
+	for (int i = 0; i < 5; i++) {
+		assert(list.Insert(new Integer(100 + i), 2 * i) == true);
+	}
+	assert(list.GetCapacity() == capacity);
+
+	string before = list.ToString();
+	Object* middle = list.Get(10);
+	list.Compact();
+	assert(list.ToString() == before);
+	assert(list.Get(10) == middle);
+	assert(list.Size() == 20);
+	assert(list.MemoryUsage().storage + list.MemoryUsage().unused == capacity * list.MemoryUsage().storage / 20);
+
+	assert(list.Insert(new Integer(-1), list.Size()) == true);
+	Integer LAST(-1);
+	assert(list.IndexOf(&LAST) == 20);
+	list.Clear();
+	list.Compact();
+	assert(list.IsEmpty());
+	assert(list.ToString() == "{}");
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestSplice(){
+	DoubleLinkedList linkedA, linkedB;
+	VSArray arrayA(2), arrayB(2);
+	for (int i = 0; i < 6; i++) {
+		linkedA.Insert(new Integer(i), linkedA.Size());
+		linkedB.Insert(new Integer(10 + i), linkedB.Size());
+		arrayA.Insert(new Integer(i), arrayA.Size());
+		arrayB.Insert(new Integer(10 + i), arrayB.Size());
+	}
+	Object* moved = linkedB.Get(2);
+	assert(linkedA.Splice(1, linkedB, 2, 3) == true);
+	assert(arrayA.Splice(1, arrayB, 2, 3) == true);
+	assert(linkedA.Get(1) == moved);
+	assert(linkedA.ToString() == "{0, 12, 13, 14, 1, 2, 3, 4, 5}");
+	assert(linkedB.ToString() == "{10, 11, 15}");
+	assert(arrayA.ToString() == linkedA.ToString());
+	assert(arrayB.ToString() == linkedB.ToString());
+	assert(linkedA.Splice(0, linkedB, 2, 2) == false);
+	assert(arrayA.Splice(0, arrayA, 0, 1) == false);
+
+	linkedA.Concat(linkedB);
+	arrayA.Concat(arrayB);
+	assert(linkedB.IsEmpty() && arrayB.IsEmpty());
+	assert(linkedA.Size() == 12 && arrayA.Size() == 12);
+	assert(linkedA.ToString() == "{0, 12, 13, 14, 1, 2, 3, 4, 5, 10, 11, 15}");
+	assert(arrayA.ToString() == linkedA.ToString());
+
+	DoubleLinkedList* linkedTail = linkedA.SplitAt(9);
+	VSArray* arrayTail = arrayA.SplitAt(9);
+	assert(linkedTail->ToString() == "{10, 11, 15}");
+	assert(arrayTail->ToString() == "{10, 11, 15}");
+	assert(linkedA.Size() == 9 && arrayA.Size() == 9);
+	// Both halves keep working as lists
+	assert(linkedA.Insert(new Integer(99), linkedA.Size()) == true);
+	assert(linkedTail->Insert(new Integer(-1), 0) == true);
+	assert(linkedA.Get(9)->ToString() == "99");
+	assert(linkedTail->ToString() == "{-1, 10, 11, 15}");
+	delete linkedTail;
+	delete arrayTail;
+
+	DoubleLinkedList* all = linkedA.SplitAt(0);
+	assert(linkedA.IsEmpty() && all->Size() == 10);
+	linkedA.Concat(*all);
+	assert(linkedA.Size() == 10 && all->IsEmpty());
+	delete all;
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestAlgorithms(){
+	VSArray array(4);
+	DoubleLinkedList linked;
+	AdaptiveList adaptive;
+	for (int i = 1; i <= 10; i++) {
+		array.Insert(new Integer(i), array.Size());
+		linked.Insert(new Integer(i), linked.Size());
+		adaptive.Insert(new Integer(i), adaptive.Size());
+	}
+	int count = 0;
+	ForEach(linked, [&count](Object*){ count++; });
+	assert(count == 10);
+
+	Integer SEVEN(7);
+	assert(Find(array, [&SEVEN](const Object& element){ return element.Equals(SEVEN); }) == 6);
+	assert(FindEqual(linked, SEVEN) == linked.IndexOf(&SEVEN));
+	assert(FindEqual(adaptive, Integer(42)) == -1);
+	assert(FindAs<Integer>(linked, [](const Integer& element){ return element.GetValue() > 8; }) == 8);
+
+	assert(AccumulateAs<Integer>(array, 0, [](int sum, const Integer& element){ return sum + element.GetValue(); }) == 55);
+	assert(AccumulateAs<Integer>(adaptive, 0, [](int sum, const Integer& element){ return sum + element.GetValue(); }) == 55);
+	assert(Accumulate(linked, size_t(0), [](size_t bytes, const Object& element){ return bytes + element.FootprintBytes(); })
+		== linked.MemoryUsage().elements);
+
+	IndexLinkedList squares(2);
+	assert(Transform(array, squares, [](const Object& element){
+		int value = ElementAs<Integer>(&element).GetValue();
+		return new Integer(value * value);
+	}) == true);
+	assert(squares.Size() == 10);
+	assert(squares.Get(9)->ToString() == "100");
+	int seen = 0;
+	ForEachAs<Integer>(squares, [&seen](const Integer& element){ seen += element.GetValue(); });
+	assert(seen == 385);
+	// A full destination stops the transform and deletes the element it refused
+	StaticArrayList<4> few;
+	assert(Transform(array, few, [](const Object& element){ return element.Clone(); }) == false);
+	assert(few.Size() == 4 && few.ToString() == "{1, 2, 3, 4}");
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+void TestReclaim(){
+	// Bounded increments in the calling thread
+	Reclaimer incremental(false);
+	DoubleLinkedList* linked = new DoubleLinkedList();
+	linked->SetReclaimer(&incremental);
+	for (int i = 0; i < 100; i++) {
+		linked->Insert(new Integer(i), linked->Size());
+	}
+	linked->Clear();
+	assert(linked->IsEmpty());
+	assert(incremental.Pending() == 1);
+	assert(incremental.Reclaim(30) == 30);
+	assert(incremental.Released() == 30);
+	// The list is still usable while its old nodes wait
+	assert(linked->Insert(new Integer(1), 0) == true);
+	assert(linked->Insert(new Integer(2), 1) == true);
+	delete linked;
+	assert(incremental.Pending() == 2);
+	incremental.Wait();
+	assert(incremental.Pending() == 0);
+	assert(incremental.Released() == 102);
+
+	// Background thread
+	Reclaimer background;
+	assert(background.IsBackground());
+	VSArray* array = new VSArray(8);
+	array->SetReclaimer(&background);
+	for (int i = 0; i < 10000; i++) {
+		array->Insert(new Integer(i), array->Size());
+	}
+	size_t capacity = array->GetCapacity();
+	array->Clear();
+	assert(array->IsEmpty());
+	assert(array->GetCapacity() == capacity);
+	for (int i = 0; i < 10; i++) {
+		assert(array->Insert(new Integer(i), 0) == true);
+	}
+	assert(array->Get(0)->ToString() == "9");
+	delete array;
+	background.Wait();
+	assert(background.Pending() == 0);
+	assert(background.Released() == 10010);
+
+	// Reclaim in this thread while the background thread releases too, Wait
+	// returns only once both are done
+	for (int round = 0; round < 4; round++){
+		DoubleLinkedList* garbage = new DoubleLinkedList();
+		garbage->SetReclaimer(&background);
+		for (int i = 0; i < 20000; i++){
+			garbage->Insert(new Integer(i), 0);
+		}
+		delete garbage;
+		background.Reclaim(Reclaimer::BATCH);
+		background.Wait();
+		assert(background.Pending() == 0);
+		assert(background.Released() == 10010 + 20000 * static_cast<size_t>(round + 1));
+	}
+
+	// Without a reclaimer everything is freed in place
+	VSArray inPlace(4);
+	inPlace.Insert(new Integer(1), 0);
+	inPlace.SetReclaimer(&background);
+	inPlace.SetReclaimer(nullptr);
+	inPlace.Clear();
+	assert(background.Released() == 90010);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestResource(){
+	MonotonicArena arena(256);
+	{
+		DoubleLinkedList linked(&arena);
+		VSArray array(2, 0.5, &arena);
+		for (int i = 0; i < 100; i++) {
+			assert(linked.Insert(new (&arena) Integer(i), linked.Size()) == true);
+			assert(array.Insert(new (&arena) Person("Name", i, &arena), array.Size()) == true);
+		}
+		assert(linked.GetResource() == &arena);
+		assert(arena.BytesAllocated() >= 100 * (sizeof(Integer) + sizeof(Person)));
+		// Removed elements go back to their resource with delete
+		delete linked.Remove(0);
+		Integer ONE(1);
+		assert(linked.IndexOf(&ONE) == 0);
+		Person NAME("Name", 99);
+		assert(array.IndexOf(&NAME) == 99);
+
+		// Lists in different resources move the elements instead of the nodes
+		DoubleLinkedList heap;
+		assert(heap.Insert(new Integer(-1), 0) == true);
+		assert(heap.Splice(1, linked, 0, 10) == true);
+		assert(heap.Size() == 11 && linked.Size() == 89);
+		assert(heap.Get(10)->ToString() == "10");
+		linked.Concat(heap);
+		assert(linked.Size() == 100 && heap.IsEmpty());
+		assert(linked.Get(89)->ToString() == "-1");
+	}
+	assert(arena.BytesReserved() > arena.BytesAllocated());
+	arena.Release();
+	assert(arena.BytesReserved() == 0 && arena.BytesAllocated() == 0);
+
+	// Nodes come from the resource of the list, deferred garbage returns them there
+	Reclaimer reclaimer(false);
+	MonotonicArena nodes(256);
+	PoolResource recycled;
+	{
+		DoubleLinkedList inArena(&nodes);
+		DoubleLinkedList inPool(&recycled);
+		inArena.SetReclaimer(&reclaimer);
+		inPool.SetReclaimer(&reclaimer);
+		for (int i = 0; i < 3; i++) {
+			inArena.Insert(new Integer(i), 0);
+			inPool.Insert(new Integer(i), 0);
+		}
+		// Three nodes of a data pointer and two links
+		assert(nodes.BytesAllocated() >= 3 * 3 * sizeof(void*));
+		inArena.Clear();
+		inPool.Clear();
+		reclaimer.Wait();
+		assert(reclaimer.Released() == 6);
+		size_t reserved = recycled.BytesReserved();
+		for (int i = 0; i < 3; i++) {
+			inPool.Insert(new Integer(i), 0);
+		}
+		assert(recycled.BytesReserved() == reserved);
+		inArena.SetReclaimer(nullptr);
+		inPool.SetReclaimer(nullptr);
+	}
+
+	// The pool recycles the blocks of deleted objects
+	PoolResource pool;
+	Object* first = new (&pool) Integer(1);
+	delete first;
+	Object* second = new (&pool) Integer(2);
+	assert(second == first);
+	Person ADA("Ada", 36);
+	Object* copy = ADA.Clone(&pool);
+	assert(copy->Equals(ADA));
+	delete copy;
+	delete second;
+	assert(pool.BytesReserved() == PoolResource::CHUNK);
+
+	// Only objects and names from a resource carry a tag naming it
+	Integer* heap = new Integer(3);
+	assert(MemoryResource::TagOverhead(heap) == 0 && MemoryResource::TaggedResource(heap) == MemoryResource::Default());
+	delete heap;
+	Person* pooled = new (&pool) Person("Grace", 85, &pool);
+	assert(MemoryResource::TaggedResource(pooled) == &pool);
+	assert(pooled->FootprintBytes() == sizeof(Person) + 6 + MemoryResource::TAG_BYTES);
+	assert(ADA.FootprintBytes() == sizeof(Person) + 4);
+	assert(sizeof(Person) == sizeof(Object) + sizeof(char*) + sizeof(size_t));
+	delete pooled;
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestFilter(){
+	VSArray array(4);
+	DoubleLinkedList linked;
+	linked.EnableFilter(16);
+	for (int i = 0; i < 200; i++) {
+		array.Insert(new Integer(i), array.Size());
+		linked.Insert(new Person("Person", i), linked.Size());
+	}
+	assert(!array.HasFilter());
+	array.EnableFilter();
+	assert(array.HasFilter() && linked.HasFilter());
+	size_t before = array.MemoryUsage().container;
+	array.DisableFilter();
+	assert(array.MemoryUsage().container < before);
+	array.EnableFilter();
+
+	Integer MISSING(-1), PRESENT(150);
+	Person NOBODY("Nobody", 1), SOMEONE("Person", 42);
+	for (int i = 0; i < 100; i++) {
+		assert(array.IndexOf(&MISSING) == -1);
+		assert(linked.IndexOf(&NOBODY) == -1);
+	}
+	assert(array.IndexOf(&PRESENT) == 150);
+	assert(linked.IndexOf(&SOMEONE) == 42);
+	FilterStats stats = array.GetFilterStats();
+	assert(stats.hits + stats.misses == 101);
+	assert(stats.hits > 90);
+	assert(stats.misses - stats.falsePositives == 1);
+	// Sized for 16 elements, the filter of linked was rebuilt on the first lookup
+	assert(linked.GetFilterStats().rebuilds == 1);
+	assert(linked.GetFilterStats().hits > 90);
+
+	// Removed elements are not found even before the filter is rebuilt
+	delete array.Remove(150);
+	assert(array.IndexOf(&PRESENT) == -1);
+	assert(array.GetFilterStats().falsePositives == stats.falsePositives + 1);
+	for (int i = 0; i < 100; i++) {
+		delete array.Remove(0);
+	}
+	assert(array.IndexOf(&PRESENT) == -1);
+	assert(array.GetFilterStats().rebuilds == 1);
+	assert(array.IndexOf(&MISSING) == -1);
+
+	// Elements moved in bulk are found after a splice
+	DoubleLinkedList other;
+	other.Insert(new Person("Nobody", 1), 0);
+	assert(linked.Splice(0, other, 0, 1) == true);
+	assert(linked.IndexOf(&NOBODY) == 0);
+	assert(other.IndexOf(&NOBODY) == -1);
+	linked.Clear();
+	assert(linked.IndexOf(&SOMEONE) == -1);
+	assert(linked.Insert(new Person("Person", 42), 0) == true);
+	assert(linked.IndexOf(&SOMEONE) == 0);
+
+	// Lists that do not keep a filter up to date do not turn it on
+	AdaptiveList adaptive;
+	CowList cow;
+	assert(array.SupportsFilter() && linked.SupportsFilter() && !adaptive.SupportsFilter() && !cow.SupportsFilter());
+	adaptive.EnableFilter(64);
+	cow.EnableFilter(64);
+	assert(!adaptive.HasFilter() && !cow.HasFilter());
+	Integer SEVEN(7);
+	adaptive.Insert(new Integer(7), 0);
+	cow.Insert(new Integer(7), 0);
+	for (List* list : {static_cast<List*>(&adaptive), static_cast<List*>(&cow)}) {
+		const Object* keys[] = {&SEVEN};
+		assert(list->IndexOf(&SEVEN) == 0 && list->CountOf(&SEVEN) == 1 && list->LastIndexOf(&SEVEN) == 0);
+		assert(list->IndexOfAny(keys, 1)[0] == 0 && list->FindAll(&SEVEN).size() == 1);
+	}
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestLoader(){
+	const char* RECORDS =	// name age position | number position
+		"Winston 55 0\n"
+		"75 0\n"
+		"Peter 43 3\n"
+		"32 3\n"
+		"Legolas 156 9\n"
+		"99 1\n"
+		"Patricia 21 0\n"
+		"130 0\n"
+		"Anna 23 1\n"
+		"1304 14";
+	// The positions assume a list that already holds five elements
+	VSArray expected(4);
+	DoubleLinkedList linked;
+	for (int i = 0; i < 5; i++) {
+		expected.Insert(new Integer(100 + i), i);
+		linked.Insert(new Integer(100 + i), i);
+	}
+	// The same records through the streams, one insert at a time
+	stringstream inputData(RECORDS);
+	string name;
+	size_t age, position, number;
+	for (size_t i = 0; i < 5; i++) {
+		inputData >> name >> age >> position;
+		assert(expected.Insert(new Person(name, age), position) == true);
+		inputData >> number >> position;
+		assert(expected.Insert(new Integer(number), position) == true);
+	}
+
+	// A tiny chunk splits records across reads
+	RecordLoader loader(MemoryResource::Default(), 5, 3);
+	stringstream input(RECORDS);
+	LoadReport report = loader.Load(input, linked);
+	assert(!report.failed);
+	assert(report.records == 10 && report.persons == 5 && report.integers == 5);
+	assert(report.rejected == 0);
+	assert(report.bytes == strlen(RECORDS));
+	assert(linked.ToString() == expected.ToString());
+
+	// Appends are inserted as runs, bad lines and positions are rejected
+	VSArray array(2);
+	stringstream appends("1 0\n2 1\r\n\n  Ada 36 2\n4 3\nnot a record at all\n5 9\nBob x 5\n6 4\n");
+	report = RecordLoader().Load(appends, array);
+	assert(report.records == 5 && report.rejected == 3);
+	assert(array.ToString() == "{1, 2, Person: {name: Ada, age: 36}, 4, 6}");
+	assert(report.RecordsPerSecond() > 0);
+
+	assert(RecordLoader().LoadFile("/nonexistent/records.txt", array).failed);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestSubList(){
+	VSArray array(4);
+	DoubleLinkedList linked;
+	for (int i = 0; i < 10; i++) {
+		array.Insert(new Integer(i), i);
+		linked.Insert(new Integer(i), i);
+	}
+	SubList<VSArray> arrayView(array, 3, 4);
+	SubList<DoubleLinkedList> linkedView(linked, 3, 4);
+	assert(arrayView.Size() == 4 && linkedView.Size() == 4);
+	assert(arrayView.ToString() == "{3, 4, 5, 6}");
+	assert(linkedView.ToString() == arrayView.ToString());
+	// The views read the elements of the lists, nothing is cloned
+	for (size_t i = 0; i < 4; i++) {
+		assert(arrayView.Get(i) == array.Get(i + 3));
+		assert(linkedView.Get(i) == linked.Get(i + 3));
+	}
+	assert(arrayView.Get(4) == nullptr && linkedView.Get(4) == nullptr);
+	Integer five(5), eight(8);
+	assert(arrayView.IndexOf(&five) == 2 && linkedView.IndexOf(&five) == 2);
+	assert(arrayView.IndexOf(&eight) == -1 && linkedView.IndexOf(&eight) == -1);
+	assert(AccumulateAs<Integer>(linkedView, 0, [](int sum, const Integer& element){ return sum + element.GetValue(); }) == 18);
+
+	// Windows are clipped to the list
+	assert(SubList<VSArray>(array, 8, 5).ToString() == "{8, 9}");
+	assert(SubList<DoubleLinkedList>(linked, 12, 5).IsEmpty());
+	assert(SubList<DoubleLinkedList>(linked, 12, 5).ToString() == "{}");
+
+	// Changing the list invalidates its views, not the views of other lists
+	delete array.Remove(0);
+	assert(!arrayView.IsValid() && arrayView.IsEmpty());
+	assert(arrayView.Get(0) == nullptr && arrayView.IndexOf(&five) == -1);
+	assert(arrayView.ToString() == "{}");
+	assert(linkedView.IsValid() && linkedView.Size() == 4);
+	linked.Insert(new Integer(10), 10);
+	assert(!linkedView.IsValid() && linkedView.IndexOf(&five) == -1);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestEditBatch(){
+	// Random bursts against every kind of list, compared with the same
+	// operations applied one by one
+	unsigned long long state = 7;
+	auto next = [&state](size_t bound){
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return static_cast<size_t>((state >> 33) % bound);
+	};
+	List* lists[] = {new VSArray(4), new DoubleLinkedList(), new IndexLinkedList(4)};
+	for (List* list : lists) {
+		list->EnableFilter(16);
+		for (int round = 0; round < 40; round++) {
+			vector<Object*> expected;
+			for (size_t i = 0; i < list->Size(); i++) {
+				expected.push_back(list->Get(i));
+			}
+			EditBatch batch(*list);
+			vector<Object*> removed;
+			size_t operations = next(12);
+			for (size_t i = 0; i < operations; i++) {
+				if (!expected.empty() && next(3) == 0) {
+					size_t position = next(expected.size());
+					removed.push_back(expected[position]);
+					expected.erase(expected.begin() + position);
+					assert(batch.Remove(position));
+				} else {
+					size_t position = next(expected.size() + 1);
+					Integer* element = new Integer(static_cast<int>(round * 100 + i));
+					expected.insert(expected.begin() + position, element);
+					assert(batch.Insert(element, position));
+				}
+			}
+			assert(!batch.Remove(expected.size()) && !batch.Insert(nullptr, expected.size() + 1));
+			assert(batch.Size() == expected.size() && batch.Operations() == operations);
+			assert(batch.Apply(*list) && batch.IsApplied());
+			assert(list->Size() == expected.size());
+			for (size_t i = 0; i < expected.size(); i++) {
+				assert(list->Get(i) == expected[i]);
+				assert(list->IndexOf(expected[i]) == static_cast<int>(i));
+			}
+			assert(batch.Removed() == removed);
+			for (Object* element : removed) {
+				delete element;
+			}
+		}
+		delete list;
+	}
+
+	// A batch applies once, and only to the list in the state it was recorded against
+	VSArray array(4);
+	for (int i = 0; i < 5; i++) {
+		array.Insert(new Integer(i), i);
+	}
+	EditBatch batch(array);
+	assert(batch.Remove(0));
+	delete array.Remove(4);
+	assert(!batch.Apply(array));
+	EditBatch fresh(array);
+	assert(fresh.Remove(0) && fresh.Remove(0) && fresh.Insert(new Integer(9), 2));
+	assert(fresh.Apply(array) && !fresh.Apply(array));
+	assert(array.ToString() == "{2, 3, 9}");
+	vector<Object*> taken = fresh.Removed();
+	assert(taken.size() == 2 && taken[0]->ToString() == "0" && taken[1]->ToString() == "1");
+	delete taken[0];
+	delete taken[1];
+
+	// A list that refuses an element keeps its elements, the batch deletes
+	// the elements it inserts
+	StaticArrayList<2> full;
+	full.Insert(new Integer(1), 0);
+	full.Insert(new Integer(2), 1);
+	EditBatch refused(full);
+	assert(refused.Insert(new Integer(3), 0));
+	assert(!refused.Apply(full) && !refused.IsApplied());
+	assert(full.ToString() == "{1, 2}" && refused.Operations() == 0 && refused.Size() == 2);
+	StaticArrayList<4> few;
+	for (int i = 0; i < 3; i++) {
+		few.Insert(new Integer(i), i);
+	}
+	EditBatch partial(few);
+	assert(partial.Remove(1) && partial.Insert(new Integer(7), 0) && partial.Insert(new Integer(8), 3));
+	assert(partial.Insert(new Integer(6), 1) && partial.Remove(1) && partial.Insert(new Integer(9), 4));
+	assert(partial.Insert(new Integer(5), 5) && partial.Size() == 6);
+	assert(!partial.Apply(few) && few.ToString() == "{0, 1, 2}");
+	assert(partial.Removed().empty());
+	assert(partial.Insert(new Integer(3), 3) && partial.Apply(few) && few.ToString() == "{0, 1, 2, 3}");
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestDefragment(){
+	// Inserts at scattered positions link the nodes out of memory order
+	unsigned long long state = 11;
+	auto next = [&state](size_t bound){
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return static_cast<size_t>((state >> 33) % bound);
+	};
+	DoubleLinkedList linked;
+	assert(linked.Locality() == 1);
+	for (int i = 0; i < 2000; i++) {
+		linked.Insert(new Integer(i), next(linked.Size() + 1));
+	}
+	assert(linked.Locality() < 0.5);
+	vector<Object*> elements;
+	ForEach(linked, [&elements](Object* element){ elements.push_back(element); });
+	linked.EnableFilter(16);
+	linked.Defragment();
+	assert(linked.Locality() == 1);
+	assert(linked.Size() == 2000 && linked.MemoryUsage().unused == 0);
+	for (size_t i = 0; i < elements.size(); i++) {
+		assert(linked.Get(i) == elements[i]);
+	}
+	assert(linked.IndexOf(elements[1999]) == 1999);
+
+	// Removed nodes stay in the block for the next inserts
+	delete linked.Remove(10);
+	delete linked.Remove(10);
+	assert(linked.MemoryUsage().unused == 2 * linked.MemoryUsage().storage / linked.Size());
+	assert(linked.Insert(new Integer(-1), 500) == true);
+	assert(linked.MemoryUsage().unused == linked.MemoryUsage().storage / linked.Size());
+
+	// Elements leave the block through splices and splits
+	DoubleLinkedList other;
+	assert(other.Splice(0, linked, 0, 100) == true);
+	assert(other.Size() == 100 && other.Get(0) == elements[0]);
+	DoubleLinkedList* tail = linked.SplitAt(1000);
+	assert(tail->Size() == 899 && linked.Size() == 1000);
+	assert(tail->Get(898) == elements[1999]);
+	linked.Concat(*tail);
+	other.Concat(linked);
+	assert(other.Size() == 1999 && linked.IsEmpty());
+	delete tail;
+
+	// Deferred destruction releases the block after the nodes
+	Reclaimer incremental(false);
+	DoubleLinkedList* deferred = new DoubleLinkedList();
+	for (int i = 0; i < 100; i++) {
+		deferred->Insert(new Integer(i), 0);
+	}
+	deferred->Defragment();
+	deferred->SetReclaimer(&incremental);
+	delete deferred;
+	incremental.Wait();
+	assert(incremental.Released() == 100);
+
+	// With a threshold the list checks its locality as it changes
+	DoubleLinkedList automatic;
+	automatic.SetDefragmentThreshold(0.9);
+	assert(automatic.GetDefragmentThreshold() == 0.9);
+	for (size_t i = 0; i < DoubleLinkedList::DEFRAGMENT_INTERVAL; i++) {
+		automatic.Insert(new Integer(static_cast<int>(i)), next(automatic.Size() + 1));
+	}
+	assert(automatic.Locality() == 1);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestDeepCopy(){
+	// Large enough for several threads
+	const size_t N = 3 * PARALLEL_GRAIN + 17;
+	VSArray array(16);
+	DoubleLinkedList linked;
+	for (size_t i = 0; i < N; i++) {
+		int value = static_cast<int>(i);
+		array.Insert(i % 3 == 0 ? static_cast<Object*>(new Person("Name", i)) : new Integer(value), i);
+		linked.Insert(i % 3 == 0 ? static_cast<Object*>(new Person("Name", i)) : new Integer(value), i);
+	}
+	assert(ParallelRanges(N, 8) == 4 && ParallelRanges(10, 8) == 1);
+	for (size_t threads : {1, 4, 0}) {
+		VSArray* arrayCopy = array.DeepCopy(threads);
+		DoubleLinkedList* linkedCopy = linked.DeepCopy(threads);
+		assert(arrayCopy->Size() == N && linkedCopy->Size() == N);
+		assert(arrayCopy->GetCapacity() == array.GetCapacity());
+		assert(linkedCopy->Locality() == 1);
+		for (size_t i = 0; i < N; i += 97) {
+			assert(arrayCopy->Get(i) != array.Get(i) && arrayCopy->Get(i)->Equals(*array.Get(i)));
+			assert(linkedCopy->Get(i) != linked.Get(i) && linkedCopy->Get(i)->Equals(*linked.Get(i)));
+		}
+		assert(linkedCopy->Get(N - 1)->Equals(*linked.Get(N - 1)));
+		delete linkedCopy->Remove(0);
+		assert(linkedCopy->Size() == N - 1);
+		delete arrayCopy;
+		delete linkedCopy;
+	}
+	delete linked.Remove(0);
+
+	// Copies in other resources are made in the calling thread
+	MonotonicArena arena;
+	DoubleLinkedList inArena(&arena);
+	for (int i = 0; i < 10; i++) {
+		inArena.Insert(new (&arena) Integer(i), 0);
+	}
+	DoubleLinkedList* arenaCopy = inArena.DeepCopy(4);
+	assert(arenaCopy->GetResource() == &arena);
+	assert(arenaCopy->Get(0)->Equals(*inArena.Get(0)) && arenaCopy->Get(9)->ToString() == "0");
+	delete arenaCopy;
+	DoubleLinkedList empty;
+	DoubleLinkedList* emptyCopy = empty.DeepCopy();
+	assert(emptyCopy->IsEmpty());
+	delete emptyCopy;
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestStatic(){
+	static_assert(StaticArrayList<8>::GetCapacity() == 8, "The capacity is a constant expression");
+	// Lives on the stack, the slots are part of the object
+	StaticArrayList<8> list;
+	assert(list.ToString() == "{}");
+	for (int i = 0; i < 8; i++) {
+		assert(list.Insert(new Integer(i), 0) == true);
+	}
+	assert(list.IsFull());
+	Integer* extra = new Integer(8);
+	assert(list.Insert(extra, 4) == false && list.Insert(extra, 8) == false);
+	assert(list.Size() == 8 && list.ToString() == "{7, 6, 5, 4, 3, 2, 1, 0}");
+	ListMemoryUsage usage = list.MemoryUsage();
+	assert(usage.storage == 8 * sizeof(Object*) && usage.unused == 0);
+	assert(usage.container + usage.storage == sizeof(list));
+
+	delete list.Remove(0);
+	assert(!list.IsFull() && list.MemoryUsage().unused == sizeof(Object*));
+	assert(list.Insert(extra, 7) == true);
+	Integer THREE(3);
+	assert(list.IndexOf(&THREE) == 3);
+	assert(FindEqual(list, THREE) == 3);
+	unsigned long long version = list.GetVersion();
+	list.Clear();
+	assert(list.IsEmpty() && list.GetVersion() != version);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+/**
+ * Name of a shared memory segment used by this process only
+ */
+string SharedName(const string& suffix){
+	stringstream retVal;
+	retVal << "/list-test-" << getpid() << "-" << suffix;
+	return retVal.str();
+}
+
+void TestShared(){
+	const string NAME = SharedName("shared");
+	SharedList* list = SharedList::Create(NAME, 64);
+	assert(list != nullptr && SharedList::Create(NAME, 64) == nullptr);
+	// Only Integer and Person are encoded, names must fit the record
+	Person* longName = new Person(string(SharedRecord::NAME_CAPACITY, 'x'), 1);
+	Object* other = new Object();
+	assert(list->Insert(longName, 0) == false && list->Insert(other, 0) == false);
+	delete longName;
+	delete other;
+
+	pid_t child = fork();
+	assert(child >= 0);
+	if (child == 0){
+		SharedList* attached = SharedList::Attach(NAME);
+		bool inserted = attached != nullptr;
+		for (int i = 0; inserted && i < 32; i++){
+			attached->Lock();
+			inserted = attached->Insert(new Integer(i), attached->Size()) &&
+				attached->Insert(new Person("Child", i), attached->Size());
+			attached->Unlock();
+		}
+		delete attached;
+		_exit(inserted ? 0 : 1);
+	}
+	int status = 0;
+	assert(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	// Size is refreshed by the next operation of this process
+	assert(list->SharedSize() == 64);
+	list->Lock();
+	assert(list->Size() == 64);
+	list->Unlock();
+
+	Object* first = list->Get(0);
+	assert(first->ToString() == "0" && list->Get(1)->ToString() == "Person: {name: Child, age: 0}");
+	Integer FIVE(5);
+	Person CHILD("Child", 5);
+	assert(list->IndexOf(&FIVE) == 10 && list->IndexOf(&CHILD) == 11);
+	assert(list->Get(10)->Equals(FIVE) && list->Get(10)->Hash() == FIVE.Hash());
+	assert(list->Get(11)->Equals(CHILD) && list->Get(11)->Hash() == CHILD.Hash());
+	assert(list->IndexOf(list->Get(11)) == 11);
+	Object* copy = list->Get(11)->Clone();
+	assert(CHILD.Equals(*copy));
+	delete copy;
+	// Views belong to the list, and the segment is full
+	Integer* refused = new Integer(64);
+	assert(list->Insert(first, 0) == false && list->Insert(refused, 0) == false);
+	delete refused;
+	ListMemoryUsage usage = list->MemoryUsage();
+	assert(usage.storage == 64 * sizeof(SharedRecord) && usage.unused == 0 && usage.elements == 0);
+
+	// A second mapping sees the same records, views read them live
+	SharedList* attached = SharedList::Attach(NAME);
+	assert(attached != nullptr && attached->GetCapacity() == 64);
+	Object* removed = attached->Remove(0);
+	assert(removed->ToString() == "0" && first->ToString() == "");
+	delete removed;
+	assert(attached->Insert(new Integer(-1), 0) == true);
+	assert(first->ToString() == "-1" && list->IndexOf(first) == 0);
+	attached->Clear();
+	assert(list->SharedSize() == 0 && list->ToString() == "{}");
+	delete attached;
+
+	// The list that created the segment removes its name
+	delete list;
+	assert(SharedList::Attach(NAME) == nullptr);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestLruCache(){
+	LruCache cache(3);
+	for (int i = 0; i < 3; i++){
+		assert(cache.Put(new Integer(i), new Person("Cached", i)) == true);
+	}
+	assert(cache.Recency().ToString() == "{2, 1, 0}");
+	Integer ZERO(0), ONE(1), THREE(3);
+	assert(cache.Get(ZERO)->ToString() == "Person: {name: Cached, age: 0}");
+	assert(cache.Get(THREE) == nullptr);
+	assert(cache.Recency().ToString() == "{0, 2, 1}");
+	// The least recently used entry is evicted from the tail
+	assert(cache.Put(new Integer(3), new Integer(30)) == true);
+	assert(cache.Size() == 3 && !cache.Contains(ONE) && cache.Recency().ToString() == "{3, 0, 2}");
+	// Peek does not change the order or the statistics
+	assert(cache.Peek(ZERO) != nullptr && cache.Recency().ToString() == "{3, 0, 2}");
+	const CacheStats& stats = cache.Stats();
+	assert(stats.hits == 1 && stats.misses == 1 && stats.insertions == 4 && stats.evictions == 1);
+	assert(stats.HitRate() == 0.5);
+
+	// Replacing a value keeps the key and moves the entry to the front
+	Integer* key = new Integer(2);
+	Integer* value = new Integer(20);
+	assert(cache.Put(key, value) == true);
+	Integer TWO(2);
+	assert(cache.Get(TWO) == value && cache.Recency().ToString() == "{2, 3, 0}");
+	assert(cache.Size() == 3 && cache.Stats().insertions == 4);
+
+	// Byte limits count the footprint of the keys and the values
+	size_t entry = sizeof(Integer) * 2;
+	assert(cache.Bytes() == 2 * entry + sizeof(Integer) + Person("Cached", 0).FootprintBytes());
+	cache.SetByteLimit(2 * entry);
+	assert(cache.Size() == 2 && !cache.Contains(ZERO) && cache.Bytes() == 2 * entry);
+	Person* large = new Person(string(3 * entry, 'x'), 1);
+	Integer* largeKey = new Integer(5);
+	assert(cache.Put(largeKey, large) == false);
+	delete large;
+	delete largeKey;
+	assert(cache.Erase(TWO) == true && cache.Erase(TWO) == false);
+	assert(cache.Size() == 1 && cache.Bytes() == entry);
+	cache.SetCapacity(0);
+	cache.SetByteLimit(0);
+	for (int i = 0; i < 100; i++){
+		cache.Put(new Integer(i), new Integer(i));
+	}
+	assert(cache.Size() == 100 && cache.Recency().Size() == 100);
+	cache.Clear();
+	assert(cache.Size() == 0 && cache.Bytes() == 0 && cache.Recency().IsEmpty());
+	cache.ResetStats();
+	assert(cache.Stats().evictions == 0);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestColumns(){
+	ColumnList list;
+	for (int i = 0; i < 6; i++){
+		Object* element = i % 2 == 0 ? static_cast<Object*>(new Integer(i)) : new Person("Column", i);
+		assert(list.Insert(element, list.Size()) == true);
+	}
+	// Other objects keep their type in the object column
+	Linkable<Integer>* linkable = new Linkable<Integer>(7);
+	assert(list.Insert(linkable, 1) == true && list.Get(1) == linkable);
+	assert(list.CountOf(ColumnList::INTEGER_COLUMN) == 3 && list.CountOf(ColumnList::PERSON_COLUMN) == 3);
+	assert(list.CountOf(ColumnList::OBJECT_COLUMN) == 1 && list.ColumnAt(2) == ColumnList::PERSON_COLUMN);
+	assert(list.ToString() == "{0, 7, Person: {name: Column, age: 1}, 2, Person: {name: Column, age: 3}, 4, "
+		"Person: {name: Column, age: 5}}");
+
+	int value = 0;
+	const char* name = nullptr;
+	size_t age = 0;
+	assert(list.IntegerAt(3, value) && value == 2 && !list.IntegerAt(2, value));
+	assert(list.PersonAt(4, name, age) && strcmp(name, "Column") == 0 && age == 3 && !list.PersonAt(3, name, age));
+	assert(list.IndexOfInteger(4) == 5 && list.IndexOfPerson("Column", 5) == 6 && list.IndexOfPerson("Column", 9) == -1);
+	Integer SEVEN(7);
+	Person COLUMN("Column", 1);
+	assert(list.IndexOf(&SEVEN) == 1 && list.IndexOf(&COLUMN) == 2);
+
+	// The queries compare the keys with the columns, nothing is materialized
+	Integer TWO(2);
+	const Object* keys[] = {&TWO, &COLUMN, &SEVEN};
+	vector<int> first = list.IndexOfAny(keys, 3);
+	assert(first[0] == 3 && first[1] == 2 && first[2] == 1);
+	assert(list.CountOf(&SEVEN) == 1 && list.LastIndexOf(&TWO) == 3 && list.FindAll(&COLUMN) == vector<size_t>(1, 2));
+	assert(list.MemoryUsage().elements == linkable->FootprintBytes());
+
+	// Get materializes an object that lives until the list changes
+	Object* materialized = list.Get(2);
+	assert(materialized->Equals(COLUMN) && list.Get(2) == materialized);
+	assert(list.MemoryUsage().elements == linkable->FootprintBytes() + materialized->FootprintBytes());
+	Object* removed = list.Remove(2);
+	assert(removed->Equals(COLUMN) && list.IndexOf(&COLUMN) == -1);
+	delete removed;
+	assert(list.MemoryUsage().elements == linkable->FootprintBytes());
+	removed = list.Remove(1);
+	assert(removed == linkable);
+	delete removed;
+	assert(list.ToString() == "{0, 2, Person: {name: Column, age: 3}, 4, Person: {name: Column, age: 5}}");
+
+	// Removed names are garbage until the pool is compacted
+	string longName(ColumnList::COMPACT_GARBAGE, 'x');
+	for (int i = 0; i < 4; i++){
+		assert(list.Insert(new Person(longName, i), 0) == true);
+	}
+	for (int i = 0; i < 4; i++){
+		delete list.Remove(0);
+	}
+	ListMemoryUsage usage = list.MemoryUsage();
+	assert(usage.unused < 2 * ColumnList::COMPACT_GARBAGE);
+	assert(list.IndexOfPerson("Column", 5) == 4 && list.Get(4)->ToString() == "Person: {name: Column, age: 5}");
+	list.EnableFilter();
+	Integer MISSING(99);
+	assert(list.IndexOf(&MISSING) == -1 && list.IndexOf(list.Get(1)) == 1);
+	// The filter is filled from the columns with the hashes of the keys, it
+	// does not exclude a person that is in the list
+	Person FIFTH("Column", 5);
+	unsigned long long hits = list.GetFilterStats().hits;
+	assert(Person::HashOf("Column", 5) == FIFTH.Hash() && list.IndexOf(&FIFTH) == 4 && list.CountOf(&FIFTH) == 1);
+	assert(list.GetFilterStats().hits == hits);
+	list.Clear();
+	assert(list.IsEmpty() && list.ToString() == "{}");
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestMultiSearch(){
+	List* lists[] = {new VSArray(4), new DoubleLinkedList(), new IndexLinkedList(4), new CowList(),
+		new AdaptiveList(4), new StaticArrayList<64>(), new ColumnList(), SharedList::Create(SharedName("search"), 64), new GapBufferList(4)};
+	Integer THREE(3), SEVEN(7), MISSING(42);
+	Person ANNA("Anna", 23);
+	for (List* list : lists){
+		for (int i = 0; i < 50; i++){
+			assert(list->Insert(new Integer(i % 10), list->Size()) == true);
+		}
+		assert(list->Insert(new Person("Anna", 23), 25) == true);
+		// Few keys are compared directly, more keys are matched by hash
+		const Object* few[] = {&SEVEN, &MISSING, nullptr};
+		vector<int> positions = list->IndexOfAny(few, 3);
+		assert(positions.size() == 3 && positions[0] == 7 && positions[1] == -1 && positions[2] == -1);
+		Integer keys[10];
+		const Object* many[12];
+		for (int i = 0; i < 10; i++){
+			keys[i].SetValue(9 - i);
+			many[i] = &keys[i];
+		}
+		many[10] = &ANNA;
+		many[11] = &THREE;
+		positions = list->IndexOfAny(many, 12);
+		for (int i = 0; i < 10; i++){
+			assert(positions[i] == 9 - i);
+		}
+		assert(positions[10] == 25 && positions[11] == 3);
+
+		assert(list->CountOf(&THREE) == 5 && list->CountOf(&ANNA) == 1 && list->CountOf(&MISSING) == 0);
+		assert(list->LastIndexOf(&THREE) == 44 && list->LastIndexOf(&MISSING) == -1);
+		vector<size_t> all = list->FindAll(&SEVEN);
+		assert(all.size() == 5 && all[0] == 7 && all[1] == 17 && all[2] == 28 && all[4] == 48);
+		assert(list->FindAll(nullptr).empty());
+	}
+	// The filter answers for the keys it excludes without scanning
+	lists[0]->EnableFilter();
+	const Object* absent[] = {&MISSING};
+	assert(lists[0]->IndexOfAny(absent, 1)[0] == -1 && lists[0]->CountOf(&MISSING) == 0);
+	assert(lists[0]->GetFilterStats().hits >= 1);
+	for (List* list : lists){
+		delete list;
+	}
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestPerfCounters(){
+	PerfCounters counters;
+	// Machines without the counters must still run the benchmarks
+	assert(counters.Available() || !counters.Error().empty());
+	assert(counters.Running() == false);
+	counters.Start();
+	assert(counters.Running() == true);
+	VSArray list(4);
+	for (int i = 0; i < 1000; i++){
+		list.Insert(new Integer(i), list.Size());
+	}
+	counters.Stop();
+	assert(counters.Running() == false);
+	if (counters.Available(PerfCounters::INSTRUCTIONS)){
+		assert(counters.Count(PerfCounters::INSTRUCTIONS) > 0);
+	}
+	for (size_t i = 0; i < PerfCounters::EVENTS; i++){
+		PerfCounters::Event event = static_cast<PerfCounters::Event>(i);
+		assert(counters.Available(event) || counters.Count(event) == 0);
+		assert(strlen(PerfCounters::Name(event)) > 0);
+	}
+	counters.Reset();
+	assert(counters.Count(PerfCounters::INSTRUCTIONS) == 0);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
+
+void TestGapBuffer(){
+	GapBufferList list(4);
+	assert(list.ToString() == "{}" && list.GetGapPosition() == 0);
+	for (int i = 0; i < 10; i++){
+		assert(list.Insert(new Integer(i), list.Size()) == true);
+	}
+	// Typing at a cursor in the middle fills the gap where it already is
+	assert(list.Insert(new Integer(20), 5) == true && list.GetGapPosition() == 6);
+	assert(list.Insert(new Integer(21), 6) == true && list.Insert(new Integer(22), 7) == true);
+	assert(list.ToString() == "{0, 1, 2, 3, 4, 20, 21, 22, 5, 6, 7, 8, 9}");
+	assert(list.Get(4)->ToString() == "4" && list.Get(8)->ToString() == "5" && list.Get(12)->ToString() == "9");
+	assert(list.Get(13) == nullptr);
+	// Backspace widens the gap, moving back and forward copies across it
+	delete list.Remove(7);
+	assert(list.GetGapPosition() == 7);
+	delete list.Remove(1);
+	assert(list.GetGapPosition() == 1 && list.ToString() == "{0, 2, 3, 4, 20, 21, 5, 6, 7, 8, 9}");
+	assert(list.Insert(new Integer(30), 10) == true && list.GetGapPosition() == 11);
+	assert(list.ToString() == "{0, 2, 3, 4, 20, 21, 5, 6, 7, 8, 30, 9}");
+	Integer* refused = new Integer(31);
+	assert(list.Insert(refused, 13) == false && list.Remove(12) == nullptr);
+	delete refused;
+
+	Integer TWENTY(20), NINE(9), MISSING(42);
+	assert(list.IndexOf(&TWENTY) == 4 && list.IndexOf(&NINE) == 11 && list.IndexOf(&MISSING) == -1);
+	assert(FindEqual(list, NINE) == 11);
+	ListMemoryUsage usage = list.MemoryUsage();
+	assert(usage.storage == 12 * sizeof(Object*));
+	assert(usage.unused == (list.GetCapacity() - 12) * sizeof(Object*));
+
+	// Growing keeps the order on both sides of the gap
+	size_t capacity = list.GetCapacity();
+	while (list.GetCapacity() == capacity){
+		assert(list.Insert(new Integer(40), 3) == true);
+	}
+	assert(list.Get(2)->ToString() == "3" && list.Get(3)->ToString() == "40");
+	assert(list.Get(list.Size() - 1)->ToString() == "9" && list.IndexOf(&NINE) == static_cast<int>(list.Size() - 1));
+	unsigned long long version = list.GetVersion();
+	list.Clear();
+	assert(list.IsEmpty() && list.GetGapPosition() == 0 && list.GetVersion() != version);
+	cout << "= = = = = = = = = = = = = = = = = = = = = " << endl;
+}
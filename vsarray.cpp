@@ -10,7 +10,12 @@
 #include "object.h"
 #include "list.h"
 #include "vsarray.h"
+#include "reclaimer.h"
+#include "memoryresource.h"
+#include "editbatch.h"
+#include "parallel.h"
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -30,9 +35,11 @@ using std::stringstream;
  * the elements of the array to nullptr
  * @param capacity the number of elements that the list is able to hold
  * @param delta the percentage change
+ * @param resource where the array is allocated
  */
-VSArray::VSArray(size_t capacity, double increasePercentage) : _capacity(capacity), _delta(increasePercentage){
-    _data = new Object*[_capacity];
+VSArray::VSArray(size_t capacity, double increasePercentage, MemoryResource* resource) : _capacity(capacity),
+    _delta(increasePercentage), _resource(resource){
+    _data = NewArray(_capacity);
     for (size_t i = 0; i < _capacity; i++) {
         _data[i] = nullptr;
     }
@@ -46,11 +53,11 @@ VSArray::VSArray(size_t capacity, double increasePercentage) : _capacity(capacit
  * done directly into the array.
  * @param list the list to be copied
  */
-VSArray::VSArray(const VSArray& list) : _capacity(list._capacity){
+VSArray::VSArray(const VSArray& list) : _capacity(list._capacity), _delta(list._delta), _resource(list._resource){
     _size = list._size;
-    _data = new Object*[_capacity];
+    _data = NewArray(_capacity);
     for (size_t i = 0; i < _size; i++) {
-        _data[i] = list.Get(i)->Clone();
+        _data[i] = list.Get(i)->Clone(_resource);
     }
     for (size_t i = _size; i < _capacity; i++){
         _data[i] = nullptr;
@@ -64,12 +71,16 @@ VSArray::VSArray(const VSArray& list) : _capacity(list._capacity){
  * 1. Traverses the list and releases the memory of each element. This in
  *    turn will call the destructor of each of the elements.
  * 2. Once the elements have been freed, then the array memory is released.
+ * With a reclaimer both steps are done later by the reclaimer.
  */
 VSArray::~VSArray(){
+    if (Defer()){
+        return;
+    }
     for (size_t i = 0; i < _size; i++) {
         delete _data[i];
     }
-    delete[] _data;
+    DeleteArray(_data, _capacity);
 }
 
 /**
@@ -88,15 +99,15 @@ const VSArray& VSArray::operator=(const VSArray& rhs){
     }
     if (_capacity != rhs._capacity){
         Clear();
-        delete[] _data;
+        DeleteArray(_data, _capacity);
         _capacity = rhs._capacity;
-        _data = new Object*[_capacity];
+        _data = NewArray(_capacity);
         for (size_t i = 0; i < _capacity; i++) {
             _data[i] = nullptr;
         }
     }
     for (size_t i = 0; i < rhs.Size(); i++) {
-        _data[i] = rhs.Get(i)->Clone();
+        _data[i] = rhs.Get(i)->Clone(_resource);
     }
     return *this;
 }
@@ -115,6 +126,7 @@ const VSArray& VSArray::operator=(const VSArray& rhs){
  * to insert if the position is invalid or if the list is full.
  */
 bool VSArray::Insert(Object* element, size_t position){
+    LIST_STATS_SCOPE(INSERT);
 
     // Check if the position is valid
     if (position > _size)
@@ -125,6 +137,7 @@ bool VSArray::Insert(Object* element, size_t position){
         Resize();
 
     if (position < _size){ // We need to shift
+        LIST_STATS_ADD(shifts, _size - position);
         // Be careful with size_t when subtracting
         for (size_t i = _size; i > position; i--){
             _data[i] = _data[i - 1];
@@ -132,6 +145,100 @@ bool VSArray::Insert(Object* element, size_t position){
     }
     _data[position] = element;
     _size++;
+    _version++;
+    FilterAdd(element);
+    return true;
+}
+
+/**
+ * Inserts a run of elements with a single resize and a single shift of
+ * the elements after position.
+ * @param elements the elements to insert, the list owns them afterwards
+ * @param count the number of elements
+ * @param position where the first element goes
+ * @return count, or 0 if the position is invalid
+ */
+size_t VSArray::InsertRange(Object* const* elements, size_t count, size_t position){
+    LIST_STATS_SCOPE(INSERT);
+    if (position > _size)
+        return 0;
+
+    if (_size + count > _capacity)
+        Resize(_size + count);
+
+    LIST_STATS_ADD(shifts, _size - position);
+    for (size_t i = _size; i > position; i--){
+        _data[i + count - 1] = _data[i - 1];
+    }
+    for (size_t i = 0; i < count; i++){
+        _data[position + i] = elements[i];
+        FilterAdd(elements[i]);
+    }
+    _size += count;
+    _version++;
+    return count;
+}
+/**
+ * Applies a batch of edits moving every surviving run of elements once.
+ * Runs that move to the left are moved first, from the first one, then the
+ * runs that move to the right, from the last one, so no run is overwritten
+ * before it is moved. The inserted elements fill the slots left between
+ * the runs.
+ * @param batch the pieces of the list after the edits
+ * @param removed where the removed elements are written, in the order of
+ * their positions before the edits
+ * @return true, the list grows as needed
+ */
+bool VSArray::ApplyBatch(const EditBatch& batch, Object** removed){
+    const vector<EditBatch::Piece>& pieces = batch.Pieces();
+    size_t size = batch.Size();
+    if (size > _capacity)
+        Resize(size);
+
+    // The positions between the runs are removed
+    size_t next = 0;
+    for (const EditBatch::Piece& piece : pieces){
+        if (piece.element == nullptr){
+            for (; next < piece.first; next++){
+                *removed++ = _data[next];
+                FilterRemoved();
+            }
+            next = piece.first + piece.count;
+        }
+    }
+    for (; next < _size; next++){
+        *removed++ = _data[next];
+        FilterRemoved();
+    }
+
+    size_t position = 0;
+    for (const EditBatch::Piece& piece : pieces){
+        if (piece.element == nullptr && position < piece.first){
+            std::copy(_data + piece.first, _data + piece.first + piece.count, _data + position);
+            LIST_STATS_ADD(shifts, piece.count);
+        }
+        position += piece.count;
+    }
+    for (size_t i = pieces.size(); i > 0; i--){
+        const EditBatch::Piece& piece = pieces[i - 1];
+        position -= piece.count;
+        if (piece.element == nullptr && position > piece.first){
+            std::copy_backward(_data + piece.first, _data + piece.first + piece.count, _data + position + piece.count);
+            LIST_STATS_ADD(shifts, piece.count);
+        }
+    }
+    for (const EditBatch::Piece& piece : pieces){
+        if (piece.element != nullptr){
+            _data[position] = piece.element;
+            FilterAdd(piece.element);
+        }
+        position += piece.count;
+    }
+    for (size_t i = size; i < _size; i++){
+        _data[i] = nullptr;
+    }
+    _size = size;
+    _version++;
     return true;
 }
 
@@ -141,16 +248,21 @@ bool VSArray::Insert(Object* element, size_t position){
  * If the element is found it returns the position, if it is not found it
  * returns -1. It is important to note that for this operation to succeed it
  * is necessary to override the method Equals of all the types inserted into
- * the list.
+ * the list. With a filter, elements certainly absent are not searched.
  * @param element the object that the client is searching for.
  * @return the position of the element if found, -1 otherwise.
  */
 int VSArray::IndexOf(const Object* element)const{
+    LIST_STATS_SCOPE(INDEX_OF);
+    if (FilterExcludes(element)){
+        return -1;
+    }
     for (size_t i = 0; i < _size; i++) {
         if (_data[i]->Equals(*element)){
             return i;
         }
     }
+    FilterMissed();
     return -1;
 }
 
@@ -166,15 +278,19 @@ int VSArray::IndexOf(const Object* element)const{
  * nullptr otherwise
  */
 Object* VSArray::Remove(size_t position){
+    LIST_STATS_SCOPE(REMOVE);
     if (position >= _size){
         return nullptr;
     }
+    LIST_STATS_ADD(shifts, _size - position - 1);
     Object* retVal = _data[position];
     for (size_t i = position; i < _size - 1; i++) {
         _data[i] = _data[i + 1];
     }
     _data[_size - 1] = nullptr;
     _size--;
+    _version++;
+    FilterRemoved();
     return retVal;
 	//return nullptr; // original return value
 }
@@ -187,6 +303,7 @@ Object* VSArray::Remove(size_t position){
  * @return a pointer to the element if the position is valid, nullptr otherwise
  */
 Object* VSArray::Get(size_t position)const{
+    LIST_STATS_SCOPE(GET);
     if (position >= _size)
         return nullptr;
     else
@@ -216,23 +333,77 @@ string VSArray::ToString()const{
  * sets the size to zero. This method makes the list become empty.
  */
 void VSArray::Clear(){
+    LIST_STATS_SCOPE(CLEAR);
+    FilterInvalidate();
+    if (_size > 0 && Defer()){
+        // Slots past the size are never read, the new array needs no nulls
+        _data = NewArray(_capacity);
+        return;
+    }
     for (size_t i = 0; i < _size; i++) {
         delete _data[i];
         _data[i] = nullptr;
     }
     _size = 0;
+    _version++;
 }
 
 /**
- * Capacity accessor
- * @return the number of elements the list is able to hold
+ * Visits the elements with Visit, one virtual call per element for the visitor
+ * @param visitor receives the elements
+ * @return true if every element was visited
+ */
+bool VSArray::Walk(ElementVisitor& visitor)const{
+    return Visit([&visitor](Object* element){
+        return visitor.Visit(element);
+    });
+}
+
+/**
+ * Checks if the list keeps a filter up to date
+ * @return true, every insert adds to the filter and Remove marks it stale
+ */
+bool VSArray::SupportsFilter()const{
+    return true;
+}
+
+/**
+ * Memory usage breakdown
+ * The slots in use are storage, the rest of the capacity is unused
+ * @return the bytes used by the list, its array and its elements
+ */
+ListMemoryUsage VSArray::MemoryUsage()const{
+    ListMemoryUsage retVal;
+    retVal.container = sizeof(VSArray) + FilterBytes();
+    retVal.storage = _size * sizeof(Object*);
+    retVal.unused = (_capacity - _size) * sizeof(Object*);
+    for (size_t i = 0; i < _size; i++) {
+        retVal.elements += _data[i]->FootprintBytes();
+    }
+    return retVal;
+}
+
+/**
+ * Resize
+ * Grows the capacity of the array by a fraction _delta, or to minimum if
+ * that is larger, the element pointers are copied into the new array.
+ * @param minimum the smallest capacity the array must have after growing
  */
-void VSArray::Resize() {
+void VSArray::Resize(size_t minimum) {
+    LIST_STATS_ADD(resizes, 1);
+    LIST_STATS_ADD(bytesMoved, _size * sizeof(Object*));
+
     // (1) Calculates capacity of resized array
     size_t higherCapacity = static_cast<size_t>(_capacity * (_delta + 1));
+    if (higherCapacity <= _capacity) {
+        higherCapacity = _capacity + 1; // Small capacities would not grow otherwise
+    }
+    if (higherCapacity < minimum) {
+        higherCapacity = minimum;
+    }
 
     // (2) Allocate new array w/ size of new capacity
-    Object** tempData = new Object*[higherCapacity];
+    Object** tempData = NewArray(higherCapacity);
 
     // (3) Assign points of original _data[i] to tempData[i]
     for (size_t i = 0; i < _size; i++) {
@@ -244,7 +415,7 @@ void VSArray::Resize() {
         tempData[i] = nullptr;
     }
 
-    delete[] _data;             // Delete data from original array
+    DeleteArray(_data, _capacity); // Delete data from original array
     _data = tempData;           // Assign tempData to original array
     _capacity = higherCapacity; // Assigned higher capacity to original array
 }
@@ -255,4 +426,180 @@ void VSArray::Resize() {
  */
 size_t VSArray::GetCapacity() const {
 	return _capacity;
-}
\ No newline at end of file
+}
+
+/**
+ * Splice
+ * Moves count elements starting at first from other into this list at
+ * position. The tail of this list is shifted once by the whole block and
+ * the gap left in other is closed once, instead of one shift per element.
+ * The elements are moved, not copied.
+ * @param position where the first moved element will be in this list
+ * @param other the list the elements are taken from, must not be this list
+ * @param first the position of the first element to move in other
+ * @param count the number of elements to move
+ * @return true if the elements were moved, false if a range is invalid
+ */
+bool VSArray::Splice(size_t position, VSArray& other, size_t first, size_t count){
+    if (&other == this || position > _size || first > other._size || count > other._size - first)
+        return false;
+
+    if (_size + count > _capacity)
+        Resize(_size + count);
+
+    LIST_STATS_ADD(shifts, _size - position);
+    for (size_t i = _size; i > position; i--) {
+        _data[i + count - 1] = _data[i - 1];
+    }
+    for (size_t i = 0; i < count; i++) {
+        _data[position + i] = other._data[first + i];
+        FilterAdd(_data[position + i]);
+    }
+    _size += count;
+    _version++;
+    if (count > 0){
+        other.FilterInvalidate();
+    }
+
+    LIST_STATS_ADD_TO(other, shifts, other._size - first - count);
+    for (size_t i = first; i + count < other._size; i++) {
+        other._data[i] = other._data[i + count];
+    }
+    for (size_t i = other._size - count; i < other._size; i++) {
+        other._data[i] = nullptr;
+    }
+    other._size -= count;
+    other._version++;
+    return true;
+}
+
+/**
+ * Concat
+ * Moves every element of other to the end of this list, other is left
+ * empty.
+ * @param other the list whose elements are appended, must not be this list
+ */
+void VSArray::Concat(VSArray& other){
+    Splice(_size, other, 0, other._size);
+}
+
+/**
+ * SplitAt
+ * Moves the elements from position to the end into a new list, this list
+ * keeps the elements before position.
+ * @param position the first element of the new list
+ * @return a newly allocated list that owns the moved elements, nullptr if
+ * the position is invalid
+ */
+VSArray* VSArray::SplitAt(size_t position){
+    if (position > _size)
+        return nullptr;
+
+    size_t count = _size - position;
+    VSArray* retVal = new VSArray(count > 0 ? count : 1, _delta, _resource);
+    retVal->Splice(0, *this, position, count);
+    return retVal;
+}
+/**
+ * Creates a deep copy with the same capacity, growth and resource. The
+ * elements are cloned in parallel, each thread clones a range of positions
+ * straight into the array of the copy. Resources other than the global
+ * heap are not synchronized, their copies are made in the calling thread.
+ * @param threads the threads to use, 0 for one per hardware thread
+ * @return a newly allocated list that owns the clones
+ */
+VSArray* VSArray::DeepCopy(size_t threads)const{
+    VSArray* retVal = new VSArray(_capacity, _delta, _resource);
+    Object** source = _data;
+    Object** destination = retVal->_data;
+    MemoryResource* resource = _resource;
+    size_t ranges = _resource->IsEqual(*MemoryResource::Default()) ? ParallelRanges(_size, threads) : 1;
+    ParallelFor(_size, ranges, [source, destination, resource](size_t, size_t first, size_t last){
+        for (size_t i = first; i < last; i++){
+            destination[i] = source[i]->Clone(resource);
+        }
+    });
+    retVal->_size = _size;
+    return retVal;
+}
+/**
+ * The array and the elements of a list handed to a reclaimer, deleted in
+ * order a budget at a time.
+ */
+class VSArray::Garbage : public Reclaimer::Garbage{
+    Object** _data;
+    size_t _size;
+    size_t _capacity;
+    MemoryResource* _resource;
+    size_t _next;
+public:
+    Garbage(Object** data, size_t size, size_t capacity, MemoryResource* resource) : _data(data), _size(size),
+        _capacity(capacity), _resource(resource), _next(0){}
+    virtual ~Garbage(){
+        Release(_size - _next);
+        _resource->Deallocate(_data, _capacity * sizeof(Object*), alignof(Object*));
+    }
+    virtual size_t Release(size_t budget){
+        size_t end = _size - _next < budget ? _size : _next + budget;
+        size_t retVal = end - _next;
+        for (; _next < end; _next++){
+            delete _data[_next];
+        }
+        return retVal;
+    }
+    virtual bool Done()const{
+        return _next == _size;
+    }
+};
+
+/**
+ * Detaches the array and hands it with the elements to the reclaimer, the
+ * list is left with no array and size zero.
+ * @return true if there is a reclaimer and the storage was handed to it
+ */
+bool VSArray::Defer(){
+    if (_reclaimer == nullptr){
+        return false;
+    }
+    _reclaimer->Defer(new Garbage(_data, _size, _capacity, _resource));
+    _data = nullptr;
+    _size = 0;
+    _version++;
+    return true;
+}
+
+/**
+ * Adds every element to the filter without going through Get
+ */
+void VSArray::FillFilter()const{
+    for (size_t i = 0; i < _size; i++) {
+        _filter->Add(_data[i]->Hash());
+    }
+}
+
+/**
+ * Allocates an array of element pointers from the resource of the list.
+ * The slots are not initialized.
+ * @param capacity the number of slots
+ * @return the array
+ */
+Object** VSArray::NewArray(size_t capacity)const{
+    return static_cast<Object**>(_resource->Allocate(capacity * sizeof(Object*), alignof(Object*)));
+}
+
+/**
+ * Gives an array allocated by NewArray back to the resource of the list
+ * @param data the array
+ * @param capacity the number of slots it was allocated with
+ */
+void VSArray::DeleteArray(Object** data, size_t capacity)const{
+    _resource->Deallocate(data, capacity * sizeof(Object*), alignof(Object*));
+}
+
+/**
+ * Resource accessor
+ * @return where the array of the list is allocated
+ */
+MemoryResource* VSArray::GetResource()const{
+    return _resource;
+}
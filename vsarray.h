@@ -14,15 +14,23 @@
 #include <string>
 using std::string;
 
-class VSArray : public List{
+class VSArray final : public List{
 	Object** _data;
 	size_t _capacity;
 	double _delta;
+	MemoryResource* _resource;
+	class Garbage;
+	template <class> friend class SubList;
 	VSArray(const VSArray&);
 	const VSArray& operator=(const VSArray&);
-	void Resize();
+	void Resize(size_t minimum = 0);
+	bool Defer();
+	virtual void FillFilter()const;
+	virtual bool ApplyBatch(const EditBatch& batch, Object** removed);
+	Object** NewArray(size_t capacity)const;
+	void DeleteArray(Object** data, size_t capacity)const;
 public:
-	VSArray(size_t capacity, double increasePercentage = 0.5);
+	VSArray(size_t capacity, double increasePercentage = 0.5, MemoryResource* resource = MemoryResource::Default());
 	virtual ~VSArray();
 
 	virtual bool Insert(Object* element, size_t position);
@@ -31,9 +39,38 @@ public:
 	virtual Object* Get(size_t position)const;
 	virtual string ToString()const;
 	virtual void Clear();
+	virtual ListMemoryUsage MemoryUsage()const;
+	virtual bool Walk(ElementVisitor& visitor)const;
+	virtual bool SupportsFilter()const;
+	virtual size_t InsertRange(Object* const* elements, size_t count, size_t position);
 	size_t GetCapacity()const;
+	MemoryResource* GetResource()const;
+
+	bool Splice(size_t position, VSArray& other, size_t first, size_t count);
+	void Concat(VSArray& other);
+	VSArray* SplitAt(size_t position);
+	VSArray* DeepCopy(size_t threads = 0)const;
+
+	template <class Visitor>
+	bool Visit(Visitor visitor)const;
 
 };
 
+/**
+ * Visits the elements in order without virtual dispatch, the loop can be
+ * inlined into the caller. Used by the algorithms in algorithms.h.
+ * @param visitor called with each element, returns false to stop
+ * @return true if every element was visited
+ */
+template <class Visitor>
+bool VSArray::Visit(Visitor visitor)const{
+	for (size_t i = 0; i < _size; i++) {
+		if (!visitor(_data[i])){
+			return false;
+		}
+	}
+	return true;
+}
+
 
 #endif //ADT_LIST_FULL_VSARRAY_H